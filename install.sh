@@ -5,20 +5,59 @@ apt-get -qq update
 apt-get -qq install build-essential
 apt-get -qq install libusb-1.0-0-dev
 echo Copying source code files...
+mkdir -p /usr/local/src/gf2-morse/bench
 mkdir -p /usr/local/src/gf2-morse/man
+cp -f src/bench/allocations.cpp /usr/local/src/gf2-morse/bench/.
+cp -f src/bench/async.cpp /usr/local/src/gf2-morse/bench/.
+cp -f src/bench/encode.cpp /usr/local/src/gf2-morse/bench/.
+cp -f src/bench/profile.cpp /usr/local/src/gf2-morse/bench/.
+cp -f src/bench/simulator.cpp /usr/local/src/gf2-morse/bench/.
+cp -f src/bench/stream.cpp /usr/local/src/gf2-morse/bench/.
+cp -f src/bench/virtualclock.cpp /usr/local/src/gf2-morse/bench/.
+cp -f src/bench/writeread.cpp /usr/local/src/gf2-morse/bench/.
+cp -f src/clock.cpp /usr/local/src/gf2-morse/.
+cp -f src/clock.h /usr/local/src/gf2-morse/.
 cp -f src/cp2130.cpp /usr/local/src/gf2-morse/.
 cp -f src/cp2130.h /usr/local/src/gf2-morse/.
 cp -f src/error.cpp /usr/local/src/gf2-morse/.
 cp -f src/error.h /usr/local/src/gf2-morse/.
+cp -f src/eventmeter.cpp /usr/local/src/gf2-morse/.
+cp -f src/eventmeter.h /usr/local/src/gf2-morse/.
 cp -f src/gf2device.cpp /usr/local/src/gf2-morse/.
 cp -f src/gf2device.h /usr/local/src/gf2-morse/.
 cp -f src/gf2-morse.cpp /usr/local/src/gf2-morse/.
+cp -f src/gf2-morsed.cpp /usr/local/src/gf2-morse/.
+cp -f src/gf2simulator.cpp /usr/local/src/gf2-morse/.
+cp -f src/gf2simulator.h /usr/local/src/gf2-morse/.
+cp -f src/hopping.cpp /usr/local/src/gf2-morse/.
+cp -f src/hopping.h /usr/local/src/gf2-morse/.
+cp -f src/keyer.cpp /usr/local/src/gf2-morse/.
+cp -f src/keyer.h /usr/local/src/gf2-morse/.
 cp -f src/GPL.txt /usr/local/src/gf2-morse/.
 cp -f src/LGPL.txt /usr/local/src/gf2-morse/.
 cp -f src/libusb-extra.c /usr/local/src/gf2-morse/.
 cp -f src/libusb-extra.h /usr/local/src/gf2-morse/.
+cp -f src/mfsk.cpp /usr/local/src/gf2-morse/.
+cp -f src/mfsk.h /usr/local/src/gf2-morse/.
+cp -f src/morsecode.cpp /usr/local/src/gf2-morse/.
+cp -f src/morsecode.h /usr/local/src/gf2-morse/.
+cp -f src/morsed.cpp /usr/local/src/gf2-morse/.
+cp -f src/morsed.h /usr/local/src/gf2-morse/.
+cp -f src/psk31.cpp /usr/local/src/gf2-morse/.
+cp -f src/psk31.h /usr/local/src/gf2-morse/.
+cp -f src/realtime.cpp /usr/local/src/gf2-morse/.
+cp -f src/realtime.h /usr/local/src/gf2-morse/.
+cp -f src/ringbuffer.h /usr/local/src/gf2-morse/.
+cp -f src/rollingmedian.h /usr/local/src/gf2-morse/.
+cp -f src/rtty.cpp /usr/local/src/gf2-morse/.
+cp -f src/rtty.h /usr/local/src/gf2-morse/.
+cp -f src/timeline.cpp /usr/local/src/gf2-morse/.
+cp -f src/timeline.h /usr/local/src/gf2-morse/.
+cp -f src/transferstats.cpp /usr/local/src/gf2-morse/.
+cp -f src/transferstats.h /usr/local/src/gf2-morse/.
 cp -f src/Makefile /usr/local/src/gf2-morse/.
 cp -f src/man/gf2-morse.1 /usr/local/src/gf2-morse/man/.
+cp -f src/man/gf2-morsed.1 /usr/local/src/gf2-morse/man/.
 cp -f src/README.txt /usr/local/src/gf2-morse/.
 echo Building and installing binaries and man pages...
 make -C /usr/local/src/gf2-morse install clean
@@ -0,0 +1,108 @@
+/* GF2 Allocation Benchmark - Version 1.0 for Debian Linux
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include "cp2130.h"
+#include "gf2device.h"
+#include "gf2simulator.h"
+
+// Definitions
+const int ITERATIONS = 1000;  // Number of iterations of each loop
+const size_t FRAME_SIZE = 2;  // Size of the frames written and read by the SPI loops (in bytes)
+
+// Global variables
+std::atomic<size_t> allocations(0);  // Number of calls to operator new, from any thread
+
+// Replacements of the global allocation functions, which count every allocation (the array forms and the nothrow forms call these)
+void *operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void *pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+int main()
+{
+    int errcnt = 0, errlvl = EXIT_SUCCESS;
+    std::string errstr;
+    GF2Simulator simulator;
+    GF2Device device;
+    device.open(simulator);
+    device.setSettleTime(0);
+    device.setFrequencyCode(GF2Device::FSEL0, 1000, errcnt, errstr);  // Warms up the device and the simulator, so that lazily allocated buffers are not counted
+    size_t before = allocations.load();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        device.setFrequencyCode(i % 2 == 1, 1000 + i, errcnt, errstr);
+        device.setFrequency(GF2Device::FSEL0, 1000.0f + i, errcnt, errstr);
+        device.setPhase(GF2Device::PSEL0, static_cast<float>(i % 360), errcnt, errstr);
+        device.setAmplitude(1.0f, errcnt, errstr);
+    }
+    size_t retune = allocations.load() - before;
+    device.close();
+    CP2130 cp2130;
+    cp2130.open(simulator);
+    uint8_t frame[FRAME_SIZE] = {0x20, 0x00};
+    std::vector<uint8_t> frameVector(frame, frame + FRAME_SIZE);
+    uint8_t readBuffer[FRAME_SIZE];
+    uint8_t endpointInAddr = cp2130.getEndpointInAddr(errcnt, errstr), endpointOutAddr = cp2130.getEndpointOutAddr(errcnt, errstr);
+    cp2130.spiWrite(frame, FRAME_SIZE, endpointOutAddr, errcnt, errstr);
+    cp2130.spiRead(readBuffer, FRAME_SIZE, endpointInAddr, endpointOutAddr, errcnt, errstr);
+    before = allocations.load();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        cp2130.spiWrite(frame, FRAME_SIZE, endpointOutAddr, errcnt, errstr);
+        cp2130.spiRead(readBuffer, FRAME_SIZE, endpointInAddr, endpointOutAddr, errcnt, errstr);
+    }
+    size_t callerOwned = allocations.load() - before;
+    before = allocations.load();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        cp2130.spiWrite(frameVector, endpointOutAddr, errcnt, errstr);
+        std::vector<uint8_t> data = cp2130.spiRead(FRAME_SIZE, endpointInAddr, endpointOutAddr, errcnt, errstr);
+    }
+    size_t vectors = allocations.load() - before;
+    cp2130.close();
+    std::cout << "Allocations per iteration: " << static_cast<double>(retune) / ITERATIONS << " retuning (setFrequencyCode(), setFrequency(), setPhase() and setAmplitude()), " << static_cast<double>(callerOwned) / ITERATIONS << " with caller-owned SPI buffers, " << static_cast<double>(vectors) / ITERATIONS << " with SPI vectors\n";
+    if (errcnt > 0) {
+        std::cerr << errstr;
+        errlvl = EXIT_FAILURE;
+    } else if (retune != 0 || callerOwned != 0) {
+        std::cerr << "Error: The retune path or the caller-owned SPI buffers allocated memory.\n";
+        errlvl = EXIT_FAILURE;
+    }
+    return errlvl;
+}
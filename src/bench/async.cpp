@@ -0,0 +1,125 @@
+/* GF2 Asynchronous Transfer Benchmark - Version 1.0 for Debian Linux
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <string>
+#include "cp2130.h"
+#include "gf2simulator.h"
+
+// Definitions
+const unsigned int LATENCIES[] = {0, 100, 500};  // Latencies of the simulated transfers (in us)
+const size_t OPERATIONS = 1000;                  // Number of operations issued by each run
+const size_t IN_FLIGHT = 8;                      // Number of asynchronous operations kept in flight
+const double SPEEDUP_MIN = 4.0;                  // Minimum speedup of asynchronous SPI writes over blocking ones, at the highest latency (control transfers are serialized on EP0, so only bulk transfers overlap)
+
+// Operations applicable to runOperations()
+const int OP_GPIO_WRITE = 0;  // Set_GPIO_Values control transfer
+const int OP_GPIO_READ = 1;   // Get_GPIO_Values control transfer
+const int OP_SPI_WRITE = 2;   // Bulk OUT transfer carrying a Write command and a 16-bit word
+const char *const OP_NAMES[] = {"GPIO write", "GPIO read", "SPI write"};
+
+// Function prototypes
+double runOperations(CP2130 &cp2130, int operation, bool async, int &errcnt, std::string &errstr);
+
+int main()
+{
+    int errcnt = 0, errlvl = EXIT_SUCCESS;
+    std::string errstr;
+    double spiSpeedup = 0;
+    for (unsigned int latency : LATENCIES) {
+        GF2Simulator simulator;
+        GF2Simulator::LatencyModel model = {latency, 0, GF2Simulator::UNIFORM};
+        simulator.setBulkLatency(model);
+        simulator.setControlLatency(model);
+        CP2130 cp2130;
+        cp2130.open(simulator);
+        for (int operation = OP_GPIO_WRITE; operation <= OP_SPI_WRITE; ++operation) {
+            double blocking = runOperations(cp2130, operation, false, errcnt, errstr);
+            double async = runOperations(cp2130, operation, true, errcnt, errstr);
+            double speedup = blocking / async;
+            std::cout << OP_NAMES[operation] << " with " << latency << "us latency: " << static_cast<int64_t>(OPERATIONS * 1e9 / blocking) << " ops/s blocking, " << static_cast<int64_t>(OPERATIONS * 1e9 / async) << " ops/s asynchronous (" << speedup << "x)\n";
+            if (operation == OP_SPI_WRITE) {
+                spiSpeedup = speedup;  // The last one measured corresponds to the highest latency
+            }
+        }
+        cp2130.close();
+    }
+    if (errcnt > 0) {
+        std::cerr << errstr;
+        errlvl = EXIT_FAILURE;
+    } else if (spiSpeedup < SPEEDUP_MIN) {
+        std::cerr << "Error: Asynchronous SPI writes are not at least " << SPEEDUP_MIN << " times faster than blocking ones.\n";
+        errlvl = EXIT_FAILURE;
+    }
+    return errlvl;
+}
+
+double runOperations(CP2130 &cp2130, int operation, bool async, int &errcnt, std::string &errstr)  // Issues the given operation repeatedly, either blocking or keeping several futures pending, and returns the time taken (in ns)
+{
+    unsigned char gpioOut[CP2130::SET_GPIO_VALUES_WLEN] = {0x00, 0x00, 0x00, 0x00};  // Mask is zero, so no pins change
+    unsigned char gpioIn[IN_FLIGHT][CP2130::GET_GPIO_VALUES_WLEN];  // One buffer per operation in flight
+    unsigned char spiOut[10] = {  // Write command header, followed by two bytes
+        0x00, 0x00,              // Reserved
+        CP2130::WRITE,           // Write command
+        0x00,                    // Reserved
+        0x02, 0x00, 0x00, 0x00,  // Length (32-bit little-endian)
+        0x20, 0x00               // AD9834 control word
+    };
+    std::future<CP2130::TransferResult> pending[IN_FLIGHT];
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < OPERATIONS && errcnt == 0; ++i) {
+        std::future<CP2130::TransferResult> &slot = pending[i % IN_FLIGHT];
+        if (async && slot.valid() && slot.get().status != LIBUSB_TRANSFER_COMPLETED) {  // The oldest operation must complete before its slot is reused
+            ++errcnt;
+            errstr += "Failed asynchronous transfer.\n";
+        }
+        if (operation == OP_GPIO_WRITE) {
+            if (async) {
+                slot = cp2130.controlTransferAsync(CP2130::SET, CP2130::SET_GPIO_VALUES, 0x0000, 0x0000, gpioOut, CP2130::SET_GPIO_VALUES_WLEN, errcnt, errstr);
+            } else {
+                cp2130.controlTransfer(CP2130::SET, CP2130::SET_GPIO_VALUES, 0x0000, 0x0000, gpioOut, CP2130::SET_GPIO_VALUES_WLEN, errcnt, errstr);
+            }
+        } else if (operation == OP_GPIO_READ) {
+            if (async) {
+                slot = cp2130.controlTransferAsync(CP2130::GET, CP2130::GET_GPIO_VALUES, 0x0000, 0x0000, gpioIn[i % IN_FLIGHT], CP2130::GET_GPIO_VALUES_WLEN, errcnt, errstr);
+            } else {
+                cp2130.controlTransfer(CP2130::GET, CP2130::GET_GPIO_VALUES, 0x0000, 0x0000, gpioIn[0], CP2130::GET_GPIO_VALUES_WLEN, errcnt, errstr);
+            }
+        } else {
+            int transferred;
+            if (async) {
+                slot = cp2130.bulkTransferAsync(0x01, spiOut, static_cast<int>(sizeof(spiOut)), errcnt, errstr);
+            } else {
+                cp2130.bulkTransfer(0x01, spiOut, static_cast<int>(sizeof(spiOut)), &transferred, errcnt, errstr);
+            }
+        }
+    }
+    for (size_t i = 0; i < IN_FLIGHT; ++i) {
+        if (pending[i].valid() && pending[i].get().status != LIBUSB_TRANSFER_COMPLETED) {
+            ++errcnt;
+            errstr += "Failed asynchronous transfer.\n";
+        }
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
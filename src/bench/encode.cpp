@@ -0,0 +1,118 @@
+/* GF2 Morse Encode Benchmark - Version 1.0 for Debian Linux
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "morsecode.h"
+
+// Definitions
+const size_t CORPUS_SIZE = 4 * 1024 * 1024;  // Size of the corpus encoded using compileMessage() (in bytes)
+const size_t REFERENCE_SIZE = 64 * 1024;     // Size of the slice of the corpus encoded using the reference encoder, which is much slower (in bytes)
+const size_t BATCH_SIZE = 4096;              // Number of characters compiled by each call to compileMessage()
+const double SPEEDUP_MIN = 5.0;              // Minimum speedup of compileMessage() over the reference encoder
+const std::string SAMPLE = "CQ CQ DE CT1ABC CT1ABC K\nThe quick brown fox jumps over the lazy dog, 0123456789 times?  (RST 599) +=/@!\n";
+
+// Function prototypes
+uint64_t encodeReference(const std::string &corpus, size_t length, size_t &elements);
+uint64_t encodeMessages(const std::string &corpus, size_t length, size_t &elements);
+
+int main()
+{
+    int errlvl = EXIT_SUCCESS;
+    std::string corpus;
+    corpus.reserve(CORPUS_SIZE + SAMPLE.size());
+    while (corpus.size() < CORPUS_SIZE) {
+        corpus += SAMPLE;
+    }
+    corpus.resize(CORPUS_SIZE);
+    size_t referenceElements, messageElements;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    uint64_t referenceUnits = encodeReference(corpus, REFERENCE_SIZE, referenceElements);
+    double reference = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    uint64_t messageUnits = encodeMessages(corpus, REFERENCE_SIZE, messageElements);
+    bool match = referenceUnits == messageUnits && referenceElements == messageElements;
+    start = std::chrono::steady_clock::now();
+    messageUnits = encodeMessages(corpus, CORPUS_SIZE, messageElements);
+    double message = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    double referencePerChar = reference / REFERENCE_SIZE, messagePerChar = message / CORPUS_SIZE;
+    std::cout << "Reference encoder (std::map rebuilt per character): " << REFERENCE_SIZE << " characters, " << referencePerChar << "ns per character\n";
+    std::cout << "compileMessage(): " << CORPUS_SIZE << " characters, " << messageElements << " elements, " << messagePerChar << "ns per character (" << referencePerChar / messagePerChar << "x)\n";
+    if (!match) {
+        std::cerr << "Error: compileMessage() and the reference encoder disagree.\n";
+        errlvl = EXIT_FAILURE;
+    } else if (referencePerChar < SPEEDUP_MIN * messagePerChar) {
+        std::cerr << "Error: Encoding is not at least " << SPEEDUP_MIN << " times faster than the reference encoder.\n";
+        errlvl = EXIT_FAILURE;
+    }
+    return errlvl;
+}
+
+uint64_t encodeReference(const std::string &corpus, size_t length, size_t &elements)  // Encodes the given number of characters of the corpus as the original encoder did, in batches of BATCH_SIZE characters, returning the duration in time units, and counting the elements
+{
+    uint64_t units = 0;
+    elements = 0;
+    for (size_t i = 0; i < length; ++i) {
+        if ((corpus[i] == '\n' || corpus[i] == ' ') && i % BATCH_SIZE > 0 && corpus[i - 1] != '\n' && corpus[i - 1] != ' ') {  // Each batch starts a new message
+            units += 4;  // Word space
+        } else {
+            char character = corpus[i];
+            if (character >= 'a' && character <= 'z') {
+                character -= 32;
+            }
+            std::map<char, std::string> charCodes{
+                {'!', "-.-.--"}, {'"', ".-..-."}, {'$', "...-..-"}, {'&', ".-..."}, {'\'', ".----."}, {'(', "-.--."}, {')', "-.--.-"}, {'+', ".-.-."},
+                {',', "--..--"}, {'-', "-....-"}, {'.', ".-.-.-"}, {'/', "-..-."}, {'0', "-----"}, {'1', ".----"}, {'2', "..---"}, {'3', "...--"},
+                {'4', "....-"}, {'5', "....."}, {'6', "-...."}, {'7', "--..."}, {'8', "---.."}, {'9', "----."}, {':', "---..."}, {';', "-.-.-."},
+                {'=', "-...-"}, {'?', "..--.."}, {'@', ".--.-."}, {'A', ".-"}, {'B', "-..."}, {'C', "-.-."}, {'D', "-.."}, {'E', "."},
+                {'F', "..-."}, {'G', "--."}, {'H', "...."}, {'I', ".."}, {'J', ".---"}, {'K', "-.-"}, {'L', ".-.."}, {'M', "--"},
+                {'N', "-."}, {'O', "---"}, {'P', ".--."}, {'Q', "--.-"}, {'R', ".-."}, {'S', "..."}, {'T', "-"}, {'U', "..-"},
+                {'V', "...-"}, {'W', ".--"}, {'X', "-..-"}, {'Y', "-.--"}, {'Z', "--.."}, {'_', "..--.-"}
+            };
+            if (charCodes.count(character) > 0) {
+                const std::string &code = charCodes[character];
+                for (size_t j = 0; j < code.size(); ++j) {
+                    units += code[j] == '-' ? 4 : 2;  // Element, followed by an intra-character space
+                    ++elements;
+                }
+                units += 2;  // Inter-character space
+            }
+        }
+    }
+    return units;
+}
+
+uint64_t encodeMessages(const std::string &corpus, size_t length, size_t &elements)  // Encodes the given number of characters of the corpus using compileMessage(), in batches of BATCH_SIZE characters, returning the duration in time units, and counting the elements
+{
+    uint64_t units = 0;
+    elements = 0;
+    for (size_t offset = 0; offset < length; offset += BATCH_SIZE) {
+        std::vector<KeyEvent> schedule = compileMessage(corpus.substr(offset, length - offset < BATCH_SIZE ? length - offset : BATCH_SIZE), 1);
+        for (const KeyEvent &event : schedule) {
+            elements += event.value ? 1 : 0;
+        }
+        units += schedule.back().deadline;  // The last event marks the end of the message
+    }
+    return units;
+}
@@ -0,0 +1,114 @@
+/* GF2 Device Profile Benchmark - Version 1.0 for Debian Linux
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "clock.h"
+#include "cp2130.h"
+#include "gf2simulator.h"
+
+// Definitions
+const size_t SESSIONS = 20;        // Number of times the device is opened, queried and closed
+const unsigned int LATENCY = 200;  // Latency of every simulated transfer (in us)
+const size_t TRANSFERS_MAX = 20;   // Maximum number of control transfers per session that uses the device profile, which are the requests issued by open()
+
+// Everything held by the device profile, as returned by the accessors
+struct Snapshot {
+    CP2130::USBConfig usbConfig;
+    CP2130::PinConfig pinConfig;
+    CP2130::SiliconVersion siliconVersion;
+    CP2130::SPIMode spiModes[11];
+    CP2130::SPIDelays spiDelays[11];
+    std::u16string manufacturer, product, serial;
+    uint8_t endpointInAddr, endpointOutAddr;
+
+    bool operator ==(const Snapshot &other) const;
+};
+
+// Function prototypes
+int64_t runSessions(bool profile, size_t &transfers, Snapshot &snapshot, int &errcnt, std::string &errstr);
+
+int main()
+{
+    int errcnt = 0, errlvl = EXIT_SUCCESS;
+    std::string errstr;
+    Snapshot snapshotQueried, snapshotProfiled;
+    size_t transfersQueried, transfersProfiled;
+    int64_t queried = runSessions(false, transfersQueried, snapshotQueried, errcnt, errstr);
+    int64_t profiled = runSessions(true, transfersProfiled, snapshotProfiled, errcnt, errstr);
+    std::cout << "Opening the device and reading its configuration with " << LATENCY << "us latency: " << queried / static_cast<int64_t>(SESSIONS) / 1000 << "us and " << transfersQueried / SESSIONS << " control transfers per session with individual queries, " << profiled / static_cast<int64_t>(SESSIONS) / 1000 << "us and " << transfersProfiled / SESSIONS << " control transfers per session with the device profile\n";
+    if (errcnt > 0) {
+        std::cerr << errstr;
+        errlvl = EXIT_FAILURE;
+    } else if (!(snapshotQueried == snapshotProfiled)) {
+        std::cerr << "Error: The device profile and the individual queries disagree.\n";
+        errlvl = EXIT_FAILURE;
+    } else if (transfersProfiled > TRANSFERS_MAX * SESSIONS || transfersProfiled >= transfersQueried) {  // Unlike the time taken, the number of transfers does not depend on how the simulator models latency
+        std::cerr << "Error: Sessions that use the device profile take more than " << TRANSFERS_MAX << " control transfers each, or no fewer than those that do not.\n";
+        errlvl = EXIT_FAILURE;
+    }
+    return errlvl;
+}
+
+// "Equal to" operator for Snapshot
+bool Snapshot::operator ==(const Snapshot &other) const
+{
+    bool equal = usbConfig == other.usbConfig && pinConfig == other.pinConfig && siliconVersion == other.siliconVersion && manufacturer == other.manufacturer && product == other.product && serial == other.serial && endpointInAddr == other.endpointInAddr && endpointOutAddr == other.endpointOutAddr;
+    for (uint8_t channel = 0; channel < 11; ++channel) {
+        equal = equal && spiModes[channel] == other.spiModes[channel] && spiDelays[channel] == other.spiDelays[channel];
+    }
+    return equal;
+}
+
+int64_t runSessions(bool profile, size_t &transfers, Snapshot &snapshot, int &errcnt, std::string &errstr)  // Opens the simulated device and reads everything the device profile holds, repeatedly, returning the time taken (in ns)
+{
+    GF2Simulator simulator;
+    GF2Simulator::LatencyModel latency = {LATENCY, 0, GF2Simulator::UNIFORM};
+    simulator.setBulkLatency(latency);
+    simulator.setControlLatency(latency);
+    CP2130 cp2130;
+    cp2130.setProfileEnabled(profile);
+    int64_t start = Clock::system().monotonicTime();
+    for (size_t i = 0; i < SESSIONS && errcnt == 0; ++i) {
+        if (cp2130.open(simulator) == CP2130::SUCCESS) {
+            snapshot.usbConfig = cp2130.getUSBConfig(errcnt, errstr);
+            snapshot.pinConfig = cp2130.getPinConfig(errcnt, errstr);
+            snapshot.siliconVersion = cp2130.getSiliconVersion(errcnt, errstr);
+            for (uint8_t channel = 0; channel < 11; ++channel) {
+                snapshot.spiModes[channel] = cp2130.getSPIMode(channel, errcnt, errstr);
+                snapshot.spiDelays[channel] = cp2130.getSPIDelays(channel, errcnt, errstr);
+            }
+            snapshot.manufacturer = cp2130.getManufacturerDesc(errcnt, errstr);
+            snapshot.product = cp2130.getProductDesc(errcnt, errstr);
+            snapshot.serial = cp2130.getSerialDesc(errcnt, errstr);
+            snapshot.endpointInAddr = cp2130.getEndpointInAddr(errcnt, errstr);
+            snapshot.endpointOutAddr = cp2130.getEndpointOutAddr(errcnt, errstr);
+            cp2130.close();
+        } else {
+            ++errcnt;
+            errstr += "Could not open the simulated device.\n";
+        }
+    }
+    int64_t duration = Clock::system().monotonicTime() - start;
+    transfers = simulator.statistics().controlTransfers;
+    return duration;
+}
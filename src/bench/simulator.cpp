@@ -0,0 +1,133 @@
+/* GF2 Simulator Benchmark - Version 1.0 for Debian Linux
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include "cp2130.h"
+#include "gf2device.h"
+#include "gf2simulator.h"
+#include "keyer.h"
+#include "morsecode.h"
+
+// Definitions
+const unsigned int LATENCY = 500;     // Latency of every simulated transfer (in us)
+const size_t OPERATIONS = 1000;       // Number of GPIO writes issued by each throughput run
+const uint64_t TUNIT = 20000000;      // Duration of a Morse code unit (in ns), corresponding to 60 WPM
+const double COMPENSATION_MIN = 2.0;  // Minimum factor by which latency compensation must reduce the mean transition error
+const int ROUNDS = 3;                 // Number of times the message is keyed in each mode, of which only the most accurate is kept, so that a preempted round does not fail the benchmark
+
+// Function prototypes
+void countTransfer(const CP2130::TransferResult &result, void *userData);
+int64_t keyMessage(bool compensate, int &errcnt, std::string &errstr);
+
+int main()
+{
+    int errcnt = 0, errlvl = EXIT_SUCCESS;
+    std::string errstr;
+    GF2Simulator simulator;
+    GF2Device device;
+    if (device.open(simulator) == GF2Device::SUCCESS) {
+        simulator.resetStatistics();
+        device.clear(errcnt, errstr);
+        GF2Simulator::Statistics statistics = simulator.statistics();
+        std::cout << "GF2Device::clear(): " << statistics.controlTransfers << " control transfers, " << statistics.bulkTransfers << " bulk transfers, " << statistics.spiBytes << " SPI bytes\n";
+        device.close();
+    }
+    GF2Simulator::LatencyModel latency = {LATENCY, 0, GF2Simulator::UNIFORM};
+    simulator.setBulkLatency(latency);
+    simulator.setControlLatency(latency);
+    CP2130 cp2130;
+    cp2130.open(simulator);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < OPERATIONS; ++i) {
+        cp2130.setGPIOs(i % 2 == 0 ? CP2130::BMGPIO0 : 0x0000, CP2130::BMGPIO0, errcnt, errstr);
+    }
+    double blocking = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::atomic<size_t> completed(0);
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < OPERATIONS; ++i) {
+        cp2130.submitGPIOs(i % 2 == 0 ? CP2130::BMGPIO0 : 0x0000, CP2130::BMGPIO0, countTransfer, &completed, errcnt, errstr);
+    }
+    while (completed.load(std::memory_order_acquire) < OPERATIONS) {  // Completions arrive from the completion thread of the simulator
+        std::this_thread::sleep_for(std::chrono::microseconds(LATENCY));
+    }
+    double async = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    cp2130.close();
+    std::cout << "GPIO writes with " << LATENCY << "us latency: " << static_cast<int64_t>(OPERATIONS * 1e9 / blocking) << " ops/s blocking, " << static_cast<int64_t>(OPERATIONS * 1e9 / async) << " ops/s asynchronous (" << blocking / async << "x)\n";
+    int64_t uncompensated = keyMessage(false, errcnt, errstr);
+    int64_t compensated = keyMessage(true, errcnt, errstr);
+    std::cout << "Mean transition error with " << LATENCY << "us latency: " << uncompensated / 1000 << "us uncompensated, " << compensated / 1000 << "us compensated\n";
+    if (errcnt > 0) {
+        std::cerr << errstr;
+        errlvl = EXIT_FAILURE;
+    } else if (async < 1000.0 * LATENCY * OPERATIONS) {  // Control transfers are serialized on EP0, so they take their full latency one after the other, even if submitted asynchronously
+        std::cerr << "Error: Control transfers overlap on the simulated device.\n";
+        errlvl = EXIT_FAILURE;
+    } else if (compensated * COMPENSATION_MIN > uncompensated) {
+        std::cerr << "Error: Latency compensation does not improve keying accuracy.\n";
+        errlvl = EXIT_FAILURE;
+    }
+    return errlvl;
+}
+
+void countTransfer(const CP2130::TransferResult &, void *userData)  // Counts a completed asynchronous transfer
+{
+    static_cast<std::atomic<size_t> *>(userData)->fetch_add(1, std::memory_order_release);
+}
+
+int64_t keyMessage(bool compensate, int &errcnt, std::string &errstr)  // Keys a short message on a simulated device, returning the lowest mean transition error among all rounds (in ns)
+{
+    GF2Simulator simulator;
+    GF2Simulator::LatencyModel latency = {LATENCY, 0, GF2Simulator::UNIFORM};
+    simulator.setBulkLatency(latency);
+    simulator.setControlLatency(latency);
+    GF2Device device;
+    int64_t error = 0;
+    if (device.open(simulator) == GF2Device::SUCCESS) {
+        Keyer keyer(device);
+        keyer.setLatencyCompensation(compensate);
+        if (compensate) {
+            keyer.calibrateLatency(errcnt, errstr);
+        }
+        std::vector<KeyEvent> schedule = compileMessage("PARIS", TUNIT);
+        std::cout << (compensate ? "Keying with latency compensation:" : "Keying without latency compensation:") << std::flush;
+        for (int i = 0; i < ROUNDS && errcnt == 0; ++i) {
+            std::cout << " " << std::flush;
+            keyer.run(schedule, errcnt, errstr);  // Characters are displayed as they are keyed
+            const Keyer::TimingReport &report = keyer.report();
+            int64_t roundError = report.transitions == 0 ? 0 : report.transitionErr / static_cast<int64_t>(report.transitions);
+            if (i == 0 || roundError < error) {
+                error = roundError;
+            }
+        }
+        std::cout << "\n";
+        device.close();
+    } else {
+        ++errcnt;
+        errstr += "Could not open the simulated device.\n";
+    }
+    return error;
+}
@@ -0,0 +1,85 @@
+/* GF2 SPI Stream Benchmark - Version 1.0 for Debian Linux
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "clock.h"
+#include "cp2130.h"
+#include "gf2device.h"
+#include "gf2simulator.h"
+
+// Definitions
+const uint32_t TABLE_ENTRIES = 4096;  // Number of frequencies in the table streamed to the AD9834, alternating between both frequency registers
+const size_t REPETITIONS = 10;        // Number of times the table is streamed at each depth
+const unsigned int LATENCY = 1000;    // Latency of every simulated transfer (in us), which exceeds the time taken to move the packets of a transfer, so that some of it can overlap
+const size_t DEPTH_COMPARED = 4;      // Depth whose throughput is compared with that of a single transfer in flight
+const double SPEEDUP_MIN = 1.15;      // Minimum speedup at the compared depth (transfers on the same endpoint only overlap in the part of their latency not spent moving packets)
+
+int main()
+{
+    int errcnt = 0, errlvl = EXIT_SUCCESS;
+    std::string errstr;
+    GF2Simulator simulator;
+    GF2Simulator::LatencyModel latency = {LATENCY, 0, GF2Simulator::UNIFORM};
+    simulator.setBulkLatency(latency);
+    simulator.setControlLatency(latency);
+    CP2130 cp2130;
+    cp2130.open(simulator);
+    cp2130.selectCS(0, errcnt, errstr);  // AD9834 on channel 0
+    uint8_t endpointOutAddr = cp2130.getEndpointOutAddr(errcnt, errstr);
+    std::vector<uint8_t> table;
+    for (uint32_t i = 0; i < TABLE_ENTRIES; ++i) {
+        std::vector<uint8_t> frame = GF2Device::frequencyFrame(i % 2 == 1, 1000 + i);
+        table.insert(table.end(), frame.begin(), frame.end());
+    }
+    std::cout << "Streaming a " << table.size() << "-byte frequency table with " << latency.base << "us latency:\n";
+    int64_t single = 0, compared = 0;
+    for (size_t depth = 1; depth <= CP2130::SPI_STREAM_DEPTH_MAX; ++depth) {
+        simulator.resetStatistics();
+        int64_t start = Clock::system().monotonicTime();
+        for (size_t i = 0; i < REPETITIONS && errcnt == 0; ++i) {
+            cp2130.spiWriteStream(table.data(), table.size(), depth, endpointOutAddr, errcnt, errstr);
+        }
+        int64_t duration = Clock::system().monotonicTime() - start;
+        GF2Simulator::Statistics statistics = simulator.statistics();
+        if (errcnt == 0 && (statistics.spiBytes != REPETITIONS * table.size() || simulator.frequencyCode(false) != 1000 + TABLE_ENTRIES - 2 || simulator.frequencyCode(true) != 1000 + TABLE_ENTRIES - 1)) {
+            ++errcnt;
+            errstr += "The frequency table was not written in full.\n";
+        }
+        if (depth == 1) {
+            single = duration;
+        } else if (depth == DEPTH_COMPARED) {
+            compared = duration;
+        }
+        std::cout << "  Depth " << depth << ": " << REPETITIONS * table.size() * 1000000000 / duration << " bytes/s, " << statistics.bulkTransfers / REPETITIONS << " bulk transfers per table\n";
+    }
+    cp2130.close();
+    if (errcnt > 0) {
+        std::cerr << errstr;
+        errlvl = EXIT_FAILURE;
+    } else if (static_cast<double>(single) / compared < SPEEDUP_MIN) {
+        std::cerr << "Error: Streaming at depth " << DEPTH_COMPARED << " is not at least " << SPEEDUP_MIN << " times faster than at depth 1.\n";
+        errlvl = EXIT_FAILURE;
+    }
+    return errlvl;
+}
@@ -0,0 +1,92 @@
+/* GF2 Virtual Clock Benchmark - Version 1.0 for Debian Linux
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "clock.h"
+#include "gf2device.h"
+#include "gf2simulator.h"
+#include "keyer.h"
+#include "morsecode.h"
+
+// Definitions
+const size_t MESSAGES = 5000;                 // Number of messages keyed
+const uint64_t TUNIT = 60000000;              // Duration of a Morse code unit (in ns), corresponding to 20 WPM
+const double MESSAGES_PER_SECOND_MIN = 1000;  // Minimum number of messages keyed per second of wall time
+const std::string MESSAGES_KEYED[] = {"CQ CQ DE CT1ABC K", "CQ  CQ\nDE CT1ABC K", "VVV VVV DE CT1ABC/B"};  // The second message only differs from the first in spaces and returns, which must collapse into the same word spaces
+
+int main()
+{
+    int errcnt = 0, errlvl = EXIT_SUCCESS;
+    std::string errstr;
+    VirtualClock clock;  // The clock and the simulator are declared before the device, so that they outlive it
+    GF2Simulator simulator;
+    simulator.setClock(&clock);
+    GF2Device device;
+    device.setClock(clock);
+    size_t messageCount = sizeof(MESSAGES_KEYED) / sizeof(MESSAGES_KEYED[0]);
+    std::vector<std::vector<KeyEvent>> schedules;
+    for (size_t i = 0; i < messageCount; ++i) {
+        schedules.push_back(compileMessage(MESSAGES_KEYED[i], TUNIT));
+    }
+    bool collapsed = schedules[0].back().deadline == schedules[1].back().deadline && schedules[0].size() == schedules[1].size();
+    size_t mistimed = 0, transitions = 0;
+    int64_t wall = 0;
+    if (device.open(simulator) == GF2Device::SUCCESS) {
+        Keyer keyer(device);
+        std::cout.setstate(std::ios::badbit);  // The keyer displays each character as it is keyed, which is suppressed here
+        int64_t start = Clock::system().monotonicTime();
+        for (size_t i = 0; i < MESSAGES && errcnt == 0; ++i) {
+            const std::vector<KeyEvent> &schedule = schedules[i % messageCount];
+            int64_t origin = clock.monotonicTime();
+            keyer.run(schedule, errcnt, errstr);
+            const Keyer::TimingReport &report = keyer.report();
+            transitions += report.transitions;
+            if (report.transitionMax != 0 || clock.monotonicTime() - origin != static_cast<int64_t>(schedule.back().deadline)) {  // Without latency, every transition must take place at its logical timestamp
+                ++mistimed;
+            }
+        }
+        wall = Clock::system().monotonicTime() - start;
+        std::cout.clear();
+        device.close();
+    } else {
+        ++errcnt;
+        errstr += "Could not open the simulated device.\n";
+    }
+    double messagesPerSecond = wall == 0 ? 0 : MESSAGES * 1000000000.0 / wall;
+    std::cout << "Virtual clock: " << MESSAGES << " messages, " << transitions << " transitions, " << clock.monotonicTime() / 1000000000 << "s of virtual time in " << wall / 1000000 << "ms (" << static_cast<int>(messagesPerSecond) << " messages/s)\n";
+    if (errcnt > 0) {
+        std::cerr << errstr;
+        errlvl = EXIT_FAILURE;
+    } else if (!collapsed) {
+        std::cerr << "Error: Consecutive spaces and returns do not collapse into a single word space.\n";
+        errlvl = EXIT_FAILURE;
+    } else if (mistimed > 0) {
+        std::cerr << "Error: " << mistimed << " messages were not keyed at their logical timestamps.\n";
+        errlvl = EXIT_FAILURE;
+    } else if (messagesPerSecond < MESSAGES_PER_SECOND_MIN) {
+        std::cerr << "Error: Fewer than " << MESSAGES_PER_SECOND_MIN << " messages were keyed per second.\n";
+        errlvl = EXIT_FAILURE;
+    }
+    return errlvl;
+}
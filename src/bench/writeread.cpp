@@ -0,0 +1,125 @@
+/* GF2 SPI WriteRead Benchmark - Version 1.0 for Debian Linux
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "clock.h"
+#include "cp2130.h"
+#include "gf2device.h"
+#include "gf2simulator.h"
+
+// Definitions
+const size_t CHUNK_COUNTS[] = {1, 2, 4, 8, 16, 32};  // Number of 56-byte chunks written and read back by each call
+const size_t REPETITIONS = 20;                        // Number of calls for each chunk count
+const unsigned int LATENCY = 200;                     // Latency of every simulated transfer (in us)
+const double SPEEDUP_MIN = 1.5;                       // Minimum speedup of the pipelined implementation over the sequential one, at the highest chunk count
+
+// Function prototypes
+size_t writeReadSequential(CP2130 &cp2130, const std::vector<uint8_t> &data, uint8_t endpointInAddr, uint8_t endpointOutAddr, int &errcnt, std::string &errstr);
+
+int main(int argc, char **argv)
+{
+    int errcnt = 0, errlvl = EXIT_SUCCESS;
+    std::string errstr;
+    GF2Simulator simulator;
+    GF2Simulator::LatencyModel latency = {LATENCY, 0, GF2Simulator::UNIFORM};
+    simulator.setBulkLatency(latency);
+    simulator.setControlLatency(latency);
+    CP2130 cp2130;
+    int err;
+    if (argc < 2) {  // The simulated device is used by default
+        err = cp2130.open(simulator);
+        std::cout << "Simulated device, " << LATENCY << "us latency:\n";
+    } else {  // Otherwise, the GF2 having the given serial number is used
+        err = cp2130.open(GF2Device::VID, GF2Device::PID, argv[1]);
+        std::cout << "Device " << argv[1] << ":\n";
+    }
+    if (err == CP2130::SUCCESS) {
+        cp2130.disableCS(0, errcnt, errstr);  // Both chip selects are disabled, so that the data is not written to the waveform generator or to the DAC of a real device
+        cp2130.disableCS(1, errcnt, errstr);
+        uint8_t endpointInAddr = cp2130.getEndpointInAddr(errcnt, errstr), endpointOutAddr = cp2130.getEndpointOutAddr(errcnt, errstr);
+        double speedup = 0;
+        for (size_t chunks : CHUNK_COUNTS) {
+            std::vector<uint8_t> data(chunks * CP2130::SPI_CHUNK_SIZE);
+            for (size_t i = 0; i < data.size(); ++i) {
+                data[i] = static_cast<uint8_t>(i);
+            }
+            size_t bytes = 0;
+            int64_t start = Clock::system().monotonicTime();
+            for (size_t i = 0; i < REPETITIONS && errcnt == 0; ++i) {
+                bytes += cp2130.spiWriteRead(data, endpointInAddr, endpointOutAddr, errcnt, errstr).size();
+            }
+            int64_t pipelined = Clock::system().monotonicTime() - start;
+            start = Clock::system().monotonicTime();
+            for (size_t i = 0; i < REPETITIONS && errcnt == 0; ++i) {
+                bytes += writeReadSequential(cp2130, data, endpointInAddr, endpointOutAddr, errcnt, errstr);
+            }
+            int64_t sequential = Clock::system().monotonicTime() - start;
+            if (errcnt == 0 && bytes != 2 * REPETITIONS * data.size()) {
+                ++errcnt;
+                errstr += "Not all bytes were read back.\n";
+            }
+            speedup = static_cast<double>(sequential) / pipelined;
+            std::cout << "  " << chunks << " chunks: " << REPETITIONS * data.size() * 1000000000 / pipelined << " bytes/s pipelined, " << REPETITIONS * data.size() * 1000000000 / sequential << " bytes/s sequential (" << speedup << "x)\n";
+        }
+        cp2130.close();
+        if (errcnt > 0) {
+            std::cerr << errstr;
+            errlvl = EXIT_FAILURE;
+        } else if (argc < 2 && speedup < SPEEDUP_MIN) {  // Only the simulated device is held to the expected speedup
+            std::cerr << "Error: Pipelined reads are not at least " << SPEEDUP_MIN << " times faster than sequential ones.\n";
+            errlvl = EXIT_FAILURE;
+        }
+    } else {
+        std::cerr << "Error: Could not open device.\n";
+        errlvl = EXIT_FAILURE;
+    }
+    return errlvl;
+}
+
+size_t writeReadSequential(CP2130 &cp2130, const std::vector<uint8_t> &data, uint8_t endpointInAddr, uint8_t endpointOutAddr, int &errcnt, std::string &errstr)  // Writes and reads back the given data one chunk at a time, waiting for each response before sending the next command, and returns the number of bytes read
+{
+    unsigned char bufferOut[CP2130::SPI_HEADER_SIZE + CP2130::SPI_CHUNK_SIZE], bufferIn[CP2130::SPI_CHUNK_SIZE];
+    size_t bytesRead = 0;
+    int preverrcnt = errcnt;
+    for (size_t offset = 0; offset < data.size() && errcnt == preverrcnt; offset += CP2130::SPI_CHUNK_SIZE) {
+        size_t payload = data.size() - offset < CP2130::SPI_CHUNK_SIZE ? data.size() - offset : CP2130::SPI_CHUNK_SIZE;
+        bufferOut[0] = 0x00;
+        bufferOut[1] = 0x00;
+        bufferOut[2] = CP2130::WRITEREAD;
+        bufferOut[3] = 0x00;
+        bufferOut[4] = static_cast<uint8_t>(payload);  // Payload length (32-bit little-endian)
+        bufferOut[5] = 0x00;
+        bufferOut[6] = 0x00;
+        bufferOut[7] = 0x00;
+        std::memcpy(bufferOut + CP2130::SPI_HEADER_SIZE, data.data() + offset, payload);
+        int bytesWritten = 0, bytesReadChunk = 0;
+        cp2130.bulkTransfer(endpointOutAddr, bufferOut, static_cast<int>(CP2130::SPI_HEADER_SIZE + payload), &bytesWritten, errcnt, errstr);
+        cp2130.bulkTransfer(endpointInAddr, bufferIn, static_cast<int>(payload), &bytesReadChunk, errcnt, errstr);
+        if (errcnt == preverrcnt) {
+            bytesRead += static_cast<size_t>(bytesReadChunk);
+        }
+    }
+    return bytesRead;
+}
@@ -0,0 +1,121 @@
+/* Clock classes - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <cerrno>
+#include <time.h>
+#include "clock.h"
+
+// Definitions
+const int64_t NSPERSEC = 1000000000;  // Number of nanoseconds in a second
+
+// Returns the time of the given system clock, in nanoseconds
+static int64_t systemTime(clockid_t clockID)
+{
+    timespec ts;
+    clock_gettime(clockID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * NSPERSEC + ts.tv_nsec;
+}
+
+Clock::~Clock()
+{
+}
+
+// Sleeps for the given duration (in nanoseconds)
+void Clock::sleepFor(int64_t duration)
+{
+    sleepUntil(monotonicTime() + duration);
+}
+
+// Returns the system clock, which is shared by all users
+Clock &Clock::system()
+{
+    static SystemClock clock;
+    return clock;
+}
+
+// Returns the current time of the monotonic clock
+int64_t SystemClock::monotonicTime() const
+{
+    return systemTime(CLOCK_MONOTONIC);
+}
+
+// Returns the current UTC time, as given by the real-time clock
+int64_t SystemClock::utcTime() const
+{
+    return systemTime(CLOCK_REALTIME);
+}
+
+// Sleeps until the given absolute time of the monotonic clock is reached
+void SystemClock::sleepUntil(int64_t time)
+{
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(time / NSPERSEC);
+    ts.tv_nsec = static_cast<long>(time % NSPERSEC);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {  // Resume sleeping if interrupted by a signal
+    }
+}
+
+// Busy-waits until the given absolute time of the monotonic clock is reached, which avoids the wakeup latency of the scheduler at the expense of a busy CPU
+void SystemClock::spinUntil(int64_t time)
+{
+    while (systemTime(CLOCK_MONOTONIC) < time) {
+    }
+}
+
+VirtualClock::VirtualClock() :
+    time_(0),
+    utcOffset_(systemTime(CLOCK_REALTIME))
+{
+}
+
+// Returns the virtual time elapsed since construction
+int64_t VirtualClock::monotonicTime() const
+{
+    return time_.load(std::memory_order_acquire);
+}
+
+// Returns the virtual UTC time
+int64_t VirtualClock::utcTime() const
+{
+    return utcOffset_ + time_.load(std::memory_order_acquire);
+}
+
+// Advances the virtual time by the given duration, which is used to account for the time spent by simulated operations
+void VirtualClock::advance(int64_t duration)
+{
+    if (duration > 0) {
+        time_.fetch_add(duration, std::memory_order_acq_rel);
+    }
+}
+
+// Advances the virtual time to the given time, returning immediately (the time never goes backwards)
+void VirtualClock::sleepUntil(int64_t time)
+{
+    int64_t current = time_.load(std::memory_order_acquire);
+    while (time > current && !time_.compare_exchange_weak(current, time, std::memory_order_acq_rel)) {
+    }
+}
+
+// Same as sleepUntil(), since there is no wakeup latency to avoid
+void VirtualClock::spinUntil(int64_t time)
+{
+    sleepUntil(time);
+}
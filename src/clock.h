@@ -0,0 +1,75 @@
+/* Clock classes - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+// Includes
+#include <atomic>
+#include <cstdint>
+
+// Source of time used for keying, so that schedules can be run against the system clock or fast-forwarded against a virtual one
+// Times are given in nanoseconds, either relative to an arbitrary monotonic origin, or since the epoch (UTC)
+class Clock
+{
+public:
+    virtual ~Clock();
+
+    virtual int64_t monotonicTime() const = 0;
+    virtual int64_t utcTime() const = 0;
+
+    void sleepFor(int64_t duration);
+    virtual void sleepUntil(int64_t time) = 0;
+    virtual void spinUntil(int64_t time) = 0;
+
+    static Clock &system();
+};
+
+// Clock that corresponds to the monotonic and real-time clocks of the system, and really sleeps
+class SystemClock : public Clock
+{
+public:
+    int64_t monotonicTime() const override;
+    int64_t utcTime() const override;
+
+    void sleepUntil(int64_t time) override;
+    void spinUntil(int64_t time) override;
+};
+
+// Clock that only advances when something sleeps on it, or explicitly advances it, so that hours of keying can be verified in seconds
+// Its UTC time corresponds to the real UTC time at construction, plus the virtual time elapsed since then
+class VirtualClock : public Clock
+{
+private:
+    std::atomic<int64_t> time_;
+    int64_t utcOffset_;
+
+public:
+    VirtualClock();
+
+    int64_t monotonicTime() const override;
+    int64_t utcTime() const override;
+
+    void advance(int64_t duration);
+    void sleepUntil(int64_t time) override;
+    void spinUntil(int64_t time) override;
+};
+
+#endif  // CLOCK_H
@@ -1,5 +1,5 @@
-/* CP2130 class - Version 1.2.5
-   Copyright (c) 2021-2022 Samuel Lourenço
+/* CP2130 class - Version 1.3.0
+   Copyright (c) 2021-2026 Samuel Lourenço
 
    This library is free software: you can redistribute it and/or modify it
    under the terms of the GNU Lesser General Public License as published by
@@ -19,9 +19,11 @@
 
 
 // Includes
+#include <algorithm>
 #include <cstring>
 #include <iomanip>
 #include <sstream>
+#include <sys/time.h>
 #include "cp2130.h"
 extern "C" {
 #include "libusb-extra.h"
@@ -29,42 +31,438 @@ extern "C" {
 
 // Definitions
 const unsigned int TR_TIMEOUT = 500;  // Transfer timeout in milliseconds
+const long EVENT_TIMEOUT = 100000;    // Maximum time the event handling thread blocks before checking if it should stop, in microseconds
+const int RTR_TIMEOUTS_MAX = 10;      // Number of consecutive IN transfers of spiReadWithRTR() that may time out without reading any data, before it gives up
+
+// Pooled asynchronous transfer
+struct CP2130::Transfer {
+    CP2130 *owner;                      // Object that submitted the transfer
+    libusb_transfer *transfer;          // Underlying libusb transfer, reused across submissions
+    std::vector<unsigned char> buffer;  // Setup packet followed by the data stage (only used by control transfers, and reused so that no allocations take place after the first submissions)
+    unsigned char *data;                // Caller buffer to which the data stage is copied on completion (only used by control IN transfers)
+    TransferCallback callback;          // Procedure to be called on completion
+    void *userData;                     // Argument to be passed to the callback
+    bool observed;                      // True if the transfer is to be reported to the transfer observer on completion
+    bool rtr;                           // True if the transfer is an IN transfer of spiReadWithRTR(), which stopRTR() cancels
+    TransferRecord record;              // Partial record to be reported (the outcome and end timestamp are filled on completion)
+};
+
+// Configuration of the device that is fetched at once, and then served by the corresponding accessors until invalidated
+struct CP2130::Profile {
+    USBConfig usbConfig;            // USB configuration, from which the endpoint addresses are also deduced
+    PinConfig pinConfig;            // Pin configuration
+    SiliconVersion siliconVersion;  // Silicon, read-only version
+    SPIMode spiModes[11];           // SPI mode of each channel
+    SPIDelays spiDelays[11];        // SPI delays of each channel
+    std::u16string manufacturer;    // Manufacturer descriptor
+    std::u16string product;         // Product descriptor
+    std::u16string serial;          // Serial descriptor
+};
+
+// State shared between a blocking transfer and its completion callback
+struct Completion {
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool done;
+    CP2130::TransferResult result;
+};
+
+// Callback used by the blocking transfers, which wakes up the waiting thread
+static void signalCompletion(const CP2130::TransferResult &result, void *userData)
+{
+    Completion *completion = static_cast<Completion *>(userData);
+    std::lock_guard<std::mutex> lock(completion->mutex);
+    completion->result = result;
+    completion->done = true;
+    completion->condition.notify_one();
+}
+
+// Waits until the given completion is signaled, and returns the corresponding transfer result
+static CP2130::TransferResult waitCompletion(Completion &completion)
+{
+    std::unique_lock<std::mutex> lock(completion.mutex);
+    while (!completion.done) {
+        completion.condition.wait(lock);
+    }
+    return completion.result;
+}
+
+// Callback used by controlTransferAsync() and bulkTransferAsync(), which fulfils the promise associated to the returned future
+static void fulfilPromise(const CP2130::TransferResult &result, void *userData)
+{
+    std::promise<CP2130::TransferResult> *promise = static_cast<std::promise<CP2130::TransferResult> *>(userData);
+    promise->set_value(result);
+    delete promise;
+}
+
+// Converts the given transfer result into the error code that the equivalent synchronous libusb function would have returned (zero if successful)
+static int transferError(const CP2130::TransferResult &result)
+{
+    int error;
+    if (result.status < 0) {  // The transfer could not be submitted, and the status already holds a libusb error code
+        error = result.status;
+    } else if (result.status == LIBUSB_TRANSFER_COMPLETED) {
+        error = LIBUSB_SUCCESS;
+    } else if (result.status == LIBUSB_TRANSFER_TIMED_OUT) {
+        error = LIBUSB_ERROR_TIMEOUT;
+    } else if (result.status == LIBUSB_TRANSFER_STALL) {
+        error = LIBUSB_ERROR_PIPE;
+    } else if (result.status == LIBUSB_TRANSFER_NO_DEVICE) {
+        error = LIBUSB_ERROR_NO_DEVICE;
+    } else if (result.status == LIBUSB_TRANSFER_OVERFLOW) {
+        error = LIBUSB_ERROR_OVERFLOW;
+    } else if (result.status == LIBUSB_TRANSFER_CANCELLED) {
+        error = LIBUSB_ERROR_INTERRUPTED;
+    } else {
+        error = LIBUSB_ERROR_IO;
+    }
+    return error;
+}
+
+// Converts the value returned by Transport::bulkTransfer() or Transport::controlTransfer() into a transfer result, as passed to transfer callbacks
+static CP2130::TransferResult transportResult(int result, int transferred)
+{
+    CP2130::TransferResult transferResult;
+    if (result < 0) {  // Failed transfer, whose libusb error code is passed as status, as if it could not be submitted
+        transferResult = {result, 0};
+    } else {
+        transferResult = {LIBUSB_TRANSFER_COMPLETED, transferred};
+    }
+    return transferResult;
+}
+
+// Returns the SPI command carried by the given bulk OUT transfer, which is found in the third byte of the command header, or zero if none
+static uint8_t bulkRequest(uint8_t endpointAddr, const unsigned char *data, int length)
+{
+    return endpointAddr < 0x80 && length >= 8 ? data[2] : 0x00;
+}
+
+// Fills the 8-byte command header that precedes the payload of every SPI transfer
+static void fillSPIHeader(unsigned char *header, uint8_t command, uint32_t length)
+{
+    header[0] = 0x00;  // Reserved
+    header[1] = 0x00;
+    header[2] = command;
+    header[3] = 0x00;  // Reserved
+    header[4] = static_cast<uint8_t>(length);
+    header[5] = static_cast<uint8_t>(length >> 8);
+    header[6] = static_cast<uint8_t>(length >> 16);
+    header[7] = static_cast<uint8_t>(length >> 24);
+}
 
 // Specific to getDescGeneric() and writeDescGeneric() (added in version 1.1.0)
 const uint16_t DESC_TBLSIZE = 0x0040;          // Descriptor table size, including preamble [64]
 const size_t DESC_MAXIDX = DESC_TBLSIZE - 2;   // Maximum usable index [62]
 const size_t DESC_IDXINCR = DESC_TBLSIZE - 1;  // Index increment or step between table preambles [63]
 
-// Private generic procedure used to get any descriptor (added as a refactor in version 1.1.0)
-std::u16string CP2130::getDescGeneric(uint8_t command, int &errcnt, std::string &errstr)
+// Returns the descriptor contained in the given tables, the second of which is only used by the manufacturer and product descriptors, if they are longer than 30 characters (added as a refactor in version 1.3.0)
+static std::u16string parseDescriptor(const unsigned char *table1, const unsigned char *table2)
 {
-    unsigned char controlBufferIn[DESC_TBLSIZE];
-    controlTransfer(GET, command, 0x0000, 0x0000, controlBufferIn, DESC_TBLSIZE, errcnt, errstr);
     std::u16string descriptor;
-    size_t length = controlBufferIn[0];
+    size_t length = table1[0];
     size_t end = length > DESC_MAXIDX ? DESC_MAXIDX : length;
     for (size_t i = 2; i < end; i += 2) {  // Process first 30 characters (bytes 2-61 of the array)
-        if (controlBufferIn[i] != 0 || controlBufferIn[i + 1] != 0) {  // Filter out null characters
-            descriptor += static_cast<char16_t>(controlBufferIn[i + 1] << 8 | controlBufferIn[i]);  // UTF-16LE conversion as per the USB 2.0 specification
+        if (table1[i] != 0 || table1[i + 1] != 0) {  // Filter out null characters
+            descriptor += static_cast<char16_t>(table1[i + 1] << 8 | table1[i]);  // UTF-16LE conversion as per the USB 2.0 specification
         }
     }
-    if ((command == GET_MANUFACTURING_STRING_1 || command == GET_PRODUCT_STRING_1) && length > DESC_MAXIDX) {
-        char16_t midchar = controlBufferIn[DESC_MAXIDX];  // Char in the middle (parted between two tables)
-        controlTransfer(GET, command + 2, 0x0000, 0x0000, controlBufferIn, DESC_TBLSIZE, errcnt, errstr);
-        midchar = static_cast<char16_t>(controlBufferIn[0] << 8 | midchar);  // Reconstruct the char in the middle
+    if (table2 != nullptr && length > DESC_MAXIDX) {
+        char16_t midchar = static_cast<char16_t>(table2[0] << 8 | table1[DESC_MAXIDX]);  // Reconstruct the char in the middle (parted between two tables)
         if (midchar != 0x0000) {  // Filter out the reconstructed char if the same is null
             descriptor += midchar;
         }
         end = length - DESC_IDXINCR;
         for (size_t i = 1; i < end; i += 2) {  // Process remaining characters, up to 31 (bytes 1-62 of the array)
-            if (controlBufferIn[i] != 0 || controlBufferIn[i + 1] != 0) {  // Again, filter out null characters
-                descriptor += static_cast<char16_t>(controlBufferIn[i + 1] << 8 | controlBufferIn[i]);  // UTF-16LE conversion as per the USB 2.0 specification
+            if (table2[i] != 0 || table2[i + 1] != 0) {  // Again, filter out null characters
+                descriptor += static_cast<char16_t>(table2[i + 1] << 8 | table2[i]);  // UTF-16LE conversion as per the USB 2.0 specification
             }
         }
     }
     return descriptor;
 }
 
+// Returns the pin configuration contained in the given Get_Pin_Config data stage (added as a refactor in version 1.3.0)
+static CP2130::PinConfig parsePinConfig(const unsigned char *controlBufferIn)
+{
+    CP2130::PinConfig config;
+    config.gpio0 = controlBufferIn[0];                                                         // GPIO.0 pin config corresponds to byte 0
+    config.gpio1 = controlBufferIn[1];                                                         // GPIO.1 pin config corresponds to byte 1
+    config.gpio2 = controlBufferIn[2];                                                         // GPIO.2 pin config corresponds to byte 2
+    config.gpio3 = controlBufferIn[3];                                                         // GPIO.3 pin config corresponds to byte 3
+    config.gpio4 = controlBufferIn[4];                                                         // GPIO.4 pin config corresponds to byte 4
+    config.gpio5 = controlBufferIn[5];                                                         // GPIO.5 pin config corresponds to byte 5
+    config.gpio6 = controlBufferIn[6];                                                         // GPIO.6 pin config corresponds to byte 6
+    config.gpio7 = controlBufferIn[7];                                                         // GPIO.7 pin config corresponds to byte 7
+    config.gpio8 = controlBufferIn[8];                                                         // GPIO.8 pin config corresponds to byte 8
+    config.gpio9 = controlBufferIn[9];                                                         // GPIO.9 pin config corresponds to byte 9
+    config.gpio10 = controlBufferIn[10];                                                       // GPIO.10 pin config corresponds to byte 10
+    config.sspndlvl = static_cast<uint16_t>(controlBufferIn[11] << 8 | controlBufferIn[12]);   // Suspend pin level bitmap corresponds to bytes 11 and 12 (big-endian conversion)
+    config.sspndmode = static_cast<uint16_t>(controlBufferIn[13] << 8 | controlBufferIn[14]);  // Suspend pin mode bitmap corresponds to bytes 13 and 14 (big-endian conversion)
+    config.wkupmask = static_cast<uint16_t>(controlBufferIn[15] << 8 | controlBufferIn[16]);   // Wakeup pin mask bitmap corresponds to bytes 15 and 16 (big-endian conversion)
+    config.wkupmatch = static_cast<uint16_t>(controlBufferIn[17] << 8 | controlBufferIn[18]);  // Wakeup pin match bitmap corresponds to bytes 17 and 18 (big-endian conversion)
+    config.divider = controlBufferIn[19];                                                      // Clock divider corresponds to byte 19
+    return config;
+}
+
+// Returns the silicon version contained in the given Get_ReadOnly_Version data stage (added as a refactor in version 1.3.0)
+static CP2130::SiliconVersion parseSiliconVersion(const unsigned char *controlBufferIn)
+{
+    CP2130::SiliconVersion version;
+    version.maj = controlBufferIn[0];  // Major read-only version corresponds to byte 0
+    version.min = controlBufferIn[1];  // Minor read-only version corresponds to byte 1
+    return version;
+}
+
+// Returns the SPI delays contained in the given Get_SPI_Delay data stage (added as a refactor in version 1.3.0)
+static CP2130::SPIDelays parseSPIDelays(const unsigned char *controlBufferIn)
+{
+    CP2130::SPIDelays delays;
+    delays.cstglen = (0x08 & controlBufferIn[1]) != 0x00;                                    // CS toggle enable corresponds to bit 3 of byte 1
+    delays.prdasten = (0x04 & controlBufferIn[1]) != 0x00;                                   // Pre-deassert delay enable corresponds to bit 2 of byte 1
+    delays.pstasten = (0x02 & controlBufferIn[1]) != 0x00;                                   // Post-assert delay enable to bit 1 of byte 1
+    delays.itbyten = (0x01 &controlBufferIn[1]) != 0x00;                                     // Inter-byte delay enable corresponds to bit 0 of byte 1
+    delays.itbytdly = static_cast<uint16_t>(controlBufferIn[2] << 8 | controlBufferIn[3]);   // Inter-byte delay corresponds to bytes 2 and 3 (big-endian conversion)
+    delays.pstastdly = static_cast<uint16_t>(controlBufferIn[4] << 8 | controlBufferIn[5]);  // Post-assert delay corresponds to bytes 4 and 5 (big-endian conversion)
+    delays.prdastdly = static_cast<uint16_t>(controlBufferIn[6] << 8 | controlBufferIn[7]);  // Pre-deassert delay corresponds to bytes 6 and 7 (big-endian conversion)
+    return delays;
+}
+
+// Returns the SPI mode of the given channel, as contained in the given Get_SPI_Word data stage (added as a refactor in version 1.3.0)
+static CP2130::SPIMode parseSPIMode(const unsigned char *controlBufferIn, uint8_t channel)
+{
+    CP2130::SPIMode mode;
+    mode.csmode = (0x08 & controlBufferIn[channel]) != 0x00;            // Chip select mode corresponds to bit 3
+    mode.cfrq = static_cast<uint8_t>(0x07 & controlBufferIn[channel]);  // Clock frequency is set in the bits 2:0
+    mode.cpha = (0x20 & controlBufferIn[channel]) != 0x00;              // Clock phase corresponds to bit 5
+    mode.cpol = (0x10 &controlBufferIn[channel]) != 0x00;               // Clock polarity corresponds to bit 4
+    return mode;
+}
+
+// Returns the USB configuration contained in the given Get_USB_Config data stage (added as a refactor in version 1.3.0)
+static CP2130::USBConfig parseUSBConfig(const unsigned char *controlBufferIn)
+{
+    CP2130::USBConfig config;
+    config.vid = static_cast<uint16_t>(controlBufferIn[1] << 8 | controlBufferIn[0]);  // VID corresponds to bytes 0 and 1 (little-endian conversion)
+    config.pid = static_cast<uint16_t>(controlBufferIn[3] << 8 | controlBufferIn[2]);  // PID corresponds to bytes 2 and 3 (little-endian conversion)
+    config.majrel = controlBufferIn[6];                                                // Major release version corresponds to byte 6
+    config.minrel = controlBufferIn[7];                                                // Minor release version corresponds to byte 7
+    config.maxpow = controlBufferIn[4];                                                // Maximum power consumption corresponds to byte 4
+    config.powmode = controlBufferIn[5];                                               // Power mode corresponds to byte 5
+    config.trfprio = controlBufferIn[8];                                               // Transfer priority corresponds to byte 8
+    return config;
+}
+
+// Private procedure used to take a transfer from the pool, or to allocate a new one if the pool is empty
+// Returns a null pointer if the transfer could not be allocated
+CP2130::Transfer *CP2130::acquireTransfer()
+{
+    Transfer *transfer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(transferMutex_);
+        if (!freeTransfers_.empty()) {
+            transfer = freeTransfers_.back();
+            freeTransfers_.pop_back();
+        }
+        ++pendingTransfers_;
+    }
+    if (transfer == nullptr) {
+        libusb_transfer *usbTransfer = transport_ != nullptr ? nullptr : libusb_alloc_transfer(0);  // Transfers done through a custom transport need no libusb transfer
+        if (usbTransfer == nullptr && transport_ == nullptr) {
+            std::lock_guard<std::mutex> lock(transferMutex_);
+            --pendingTransfers_;
+            transferCondition_.notify_all();
+        } else {
+            transfer = new Transfer;
+            transfer->owner = this;
+            transfer->transfer = usbTransfer;
+        }
+    }
+    return transfer;
+}
+
+// Private procedure used to report a failed bulk transfer, given the error code returned by libusb (added as a refactor in version 1.3.0)
+void CP2130::bulkTransferFailed(uint8_t endpointAddr, int result, int &errcnt, std::string &errstr)
+{
+    ++errcnt;
+    std::ostringstream stream;
+    if (endpointAddr < 0x80) {
+        stream << "Failed bulk OUT transfer to endpoint "
+               << (0x0f & endpointAddr)
+               << " (address 0x"
+               << std::hex << std::setfill ('0') << std::setw(2) << static_cast<int>(endpointAddr)
+               << ")." << std::endl;
+    } else {
+        stream << "Failed bulk IN transfer from endpoint "
+               << (0x0f & endpointAddr)
+               << " (address 0x"
+               << std::hex << std::setfill ('0') << std::setw(2) << static_cast<int>(endpointAddr)
+               << ")." << std::endl;
+    }
+    errstr += stream.str();
+    if (result == LIBUSB_ERROR_NO_DEVICE || result == LIBUSB_ERROR_IO) {  // Note that libusb_bulk_transfer() may return "LIBUSB_ERROR_IO" [-1] on device disconnect
+        disconnected_ = true;  // This reports that the device has been disconnected
+    }
+}
+
+// Private generic procedure used to perform a blocking bulk transfer, observed as carrying the given SPI command
+void CP2130::bulkTransferGeneric(uint8_t endpointAddr, uint8_t command, unsigned char *data, int length, int *transferred, int &errcnt, std::string &errstr)
+{
+    if (!isOpen()) {
+        ++errcnt;
+        errstr += "In bulkTransfer(): device is not open.\n";  // Program logic error
+    } else {
+        int result, bytesTransferred = 0;
+        if (onCompletionThread()) {  // If called from a completion callback, the transfer cannot wait for the event handling thread (or for the completion thread of the transport), so it is done synchronously
+            int64_t start = observer_ != nullptr ? observer_->timestamp() : 0;
+            if (transport_ != nullptr) {
+                result = transport_->bulkTransfer(endpointAddr, data, length, &bytesTransferred);
+            } else {
+                result = libusb_bulk_transfer(handle_, endpointAddr, data, length, &bytesTransferred, TR_TIMEOUT);
+            }
+            observeTransfer(endpointAddr < 0x80 ? TRANSFER_BULK_OUT : TRANSFER_BULK_IN, command, length, result == 0, start);
+        } else {  // Transfers submitted to the event handling thread are observed on completion
+            Completion completion;
+            completion.done = false;
+            submitBulkTransferGeneric(endpointAddr, command, data, length, signalCompletion, &completion, errcnt, errstr);
+            TransferResult transferResult = waitCompletion(completion);
+            result = transferError(transferResult);
+            bytesTransferred = transferResult.transferred;
+        }
+        if (transferred != nullptr) {
+            *transferred = bytesTransferred;
+        }
+        if (result != 0 || (transferred != nullptr && *transferred != length)) {  // The number of transferred bytes is also verified, as long as a valid (non-null) pointer is passed via "transferred"
+            bulkTransferFailed(endpointAddr, result, errcnt, errstr);
+        }
+    }
+}
+
+// Private procedure used to report a failed control transfer, given the value returned by libusb_control_transfer() (added as a refactor in version 1.3.0)
+void CP2130::controlTransferFailed(uint8_t bmRequestType, uint8_t bRequest, int result, int &errcnt, std::string &errstr)
+{
+    ++errcnt;
+    std::ostringstream stream;
+    stream << "Failed control transfer (0x"
+           << std::hex << std::setfill ('0') << std::setw(2) << static_cast<int>(bmRequestType)
+           << ", 0x"
+           << std::setw(2) << static_cast<int>(bRequest)
+           << ")." << std::endl;
+    errstr += stream.str();
+    if (result == LIBUSB_ERROR_NO_DEVICE || result == LIBUSB_ERROR_IO || result == LIBUSB_ERROR_PIPE) {  // Note that libusb_control_transfer() may return "LIBUSB_ERROR_IO" [-1] or "LIBUSB_ERROR_PIPE" [-9] on device disconnect
+        disconnected_ = true;  // This reports that the device has been disconnected
+    }
+}
+
+// Private function used to fill the given slot of the SPI transfer buffer with the WriteRead command corresponding to the given chunk of data, returning the size of its payload
+uint32_t CP2130::fillSPIChunk(unsigned char *slot, const std::vector<uint8_t> &data, size_t chunk)
+{
+    size_t offset = chunk * SPI_CHUNK_SIZE;
+    size_t bytesRemaining = data.size() - offset;
+    size_t payload = SPI_CHUNK_SIZE;
+    if (bytesRemaining < payload) {
+        payload = bytesRemaining;
+    }
+    fillSPIHeader(slot, WRITEREAD, static_cast<uint32_t>(payload));
+    std::memcpy(slot + SPI_HEADER_SIZE, data.data() + offset, payload);
+    return static_cast<uint32_t>(payload);
+}
+
+// Private generic procedure used to get any descriptor (added as a refactor in version 1.1.0)
+std::u16string CP2130::getDescGeneric(uint8_t command, int &errcnt, std::string &errstr)
+{
+    unsigned char controlBufferIn[2][DESC_TBLSIZE];
+    controlTransfer(GET, command, 0x0000, 0x0000, controlBufferIn[0], DESC_TBLSIZE, errcnt, errstr);
+    bool parted = (command == GET_MANUFACTURING_STRING_1 || command == GET_PRODUCT_STRING_1) && controlBufferIn[0][0] > DESC_MAXIDX;  // True if the descriptor continues in a second table
+    if (parted) {
+        controlTransfer(GET, command + 2, 0x0000, 0x0000, controlBufferIn[1], DESC_TBLSIZE, errcnt, errstr);
+    }
+    return parseDescriptor(controlBufferIn[0], parted ? controlBufferIn[1] : nullptr);
+}
+
+// Private procedure run by the event handling thread, which completes asynchronous transfers until the device is closed
+void CP2130::handleEvents()
+{
+    while (!stopEvents_) {
+        timeval timeout = {0, EVENT_TIMEOUT};
+        libusb_handle_events_timeout_completed(context_, &timeout, nullptr);
+    }
+}
+
+// Private function that checks if the calling thread is the one from which completion callbacks are invoked, in which case transfers cannot be waited for
+bool CP2130::onCompletionThread() const
+{
+    return transport_ != nullptr ? transport_->isCompletionThread() : std::this_thread::get_id() == eventThread_.get_id();
+}
+
+// Private procedure used to report a completed transfer to the transfer observer, if any
+void CP2130::observeTransfer(uint8_t type, uint8_t request, int length, bool success, int64_t start)
+{
+    if (observer_ != nullptr) {
+        observer_->transferCompleted({type, request, length, success, start, observer_->timestamp()});
+    }
+}
+
+// Private procedure used to return a transfer to the pool, once it is completed
+void CP2130::releaseTransfer(Transfer *transfer)
+{
+    std::lock_guard<std::mutex> lock(transferMutex_);
+    if (transfer->rtr) {
+        rtrTransfers_.erase(std::find(rtrTransfers_.begin(), rtrTransfers_.end(), transfer));
+    }
+    freeTransfers_.push_back(transfer);
+    --pendingTransfers_;
+    transferCondition_.notify_all();
+}
+
+// Private generic procedure used to submit a bulk transfer, observed as carrying the given SPI command
+void CP2130::submitBulkTransferGeneric(uint8_t endpointAddr, uint8_t command, unsigned char *data, int length, TransferCallback callback, void *userData, int &errcnt, std::string &errstr)
+{
+    Transfer *transfer;
+    if (!isOpen()) {
+        ++errcnt;
+        errstr += "In submitBulkTransfer(): device is not open.\n";  // Program logic error
+        callback({LIBUSB_ERROR_NO_DEVICE, 0}, userData);
+    } else if ((transfer = acquireTransfer()) == nullptr) {
+        callback({LIBUSB_ERROR_NO_MEM, 0}, userData);
+    } else {
+        transfer->observed = observer_ != nullptr;
+        if (transfer->observed) {
+            transfer->record = {endpointAddr < 0x80 ? TRANSFER_BULK_OUT : TRANSFER_BULK_IN, command, length, false, observer_->timestamp(), 0};
+        }
+        transfer->data = nullptr;
+        transfer->callback = callback;
+        transfer->userData = userData;
+        transfer->rtr = false;
+        if (transport_ != nullptr) {
+            transport_->submitBulkTransfer(endpointAddr, data, length, completeTransportTransfer, transfer);
+        } else {
+            libusb_fill_bulk_transfer(transfer->transfer, handle_, endpointAddr, data, length, completeTransfer, transfer, TR_TIMEOUT);
+            if (endpointAddr >= 0x80 && endpointAddr == rtrEndpointAddr_) {  // Registered before being submitted, since it may complete right away
+                std::lock_guard<std::mutex> lock(transferMutex_);
+                transfer->rtr = true;
+                rtrTransfers_.push_back(transfer);
+            }
+            submitTransfer(transfer);
+        }
+    }
+}
+
+// Private procedure used to submit a filled transfer
+// If the submission fails, the transfer is released and the callback is invoked immediately, with the libusb error code as status
+void CP2130::submitTransfer(Transfer *transfer)
+{
+    int result = libusb_submit_transfer(transfer->transfer);
+    if (result != 0) {
+        if (result == LIBUSB_ERROR_NO_DEVICE) {
+            disconnected_ = true;  // This reports that the device has been disconnected
+        }
+        TransferCallback callback = transfer->callback;
+        void *userData = transfer->userData;
+        releaseTransfer(transfer);
+        callback({result, 0}, userData);
+    }
+}
+
 // Private generic procedure used to write any descriptor (added as a refactor in version 1.1.0)
 void CP2130::writeDescGeneric(const std::u16string &descriptor, uint8_t command, int &errcnt, std::string &errstr)
 {
@@ -86,6 +484,79 @@ void CP2130::writeDescGeneric(const std::u16string &descriptor, uint8_t command,
         }
         controlTransfer(SET, command + 2 * i, PROM_WRITE_KEY, 0x0000, controlBufferOut, DESC_TBLSIZE, errcnt, errstr);
     }
+    invalidateProfile();  // Writing to the OTP ROM invalidates the device profile
+}
+
+// Private static procedure called by libusb, from the event handling thread, when an asynchronous transfer completes
+// The transfer is returned to the pool before the callback is invoked, so that the callback may submit further transfers
+void LIBUSB_CALL CP2130::completeTransfer(libusb_transfer *usbTransfer)
+{
+    Transfer *transfer = static_cast<Transfer *>(usbTransfer->user_data);
+    TransferResult result = {usbTransfer->status, usbTransfer->actual_length};  // Note that, for control transfers, the actual length does not include the setup packet
+    if (usbTransfer->type == LIBUSB_TRANSFER_TYPE_CONTROL && transfer->data != nullptr) {  // Control IN transfer
+        std::memcpy(transfer->data, libusb_control_transfer_get_data(usbTransfer), static_cast<size_t>(usbTransfer->actual_length));
+    }
+    if (usbTransfer->status == LIBUSB_TRANSFER_NO_DEVICE) {
+        transfer->owner->disconnected_ = true;  // This reports that the device has been disconnected
+    }
+    if (transfer->observed) {
+        transfer->owner->observeTransfer(transfer->record.type, transfer->record.request, transfer->record.length, usbTransfer->status == LIBUSB_TRANSFER_COMPLETED, transfer->record.start);
+    }
+    TransferCallback callback = transfer->callback;
+    void *userData = transfer->userData;
+    transfer->owner->releaseTransfer(transfer);
+    callback(result, userData);
+}
+
+// Private static procedure called by a custom transport, usually from its own completion thread, when an asynchronous transfer completes
+// This is the counterpart of completeTransfer(), for transfers that were submitted to a custom transport
+void CP2130::completeTransportTransfer(const TransferResult &result, void *userData)
+{
+    Transfer *transfer = static_cast<Transfer *>(userData);
+    if (transfer->data != nullptr && result.transferred > 0) {  // Control IN transfer
+        std::memcpy(transfer->data, transfer->buffer.data() + LIBUSB_CONTROL_SETUP_SIZE, static_cast<size_t>(result.transferred));
+    }
+    if (result.status == LIBUSB_ERROR_NO_DEVICE) {
+        transfer->owner->disconnected_ = true;  // This reports that the device has been disconnected
+    }
+    if (transfer->observed) {
+        transfer->owner->observeTransfer(transfer->record.type, transfer->record.request, transfer->record.length, result.status == LIBUSB_TRANSFER_COMPLETED, transfer->record.start);
+    }
+    TransferCallback callback = transfer->callback;
+    void *transferUserData = transfer->userData;
+    transfer->owner->releaseTransfer(transfer);
+    callback(result, transferUserData);
+}
+
+// Destructor of Transport, which only exists so that implementations can be deleted through a base pointer
+CP2130::Transport::~Transport()
+{
+}
+
+// Checks if the calling thread is the one from which the transport invokes completion callbacks (by default, callbacks are invoked from the submitting thread, so this always returns false)
+bool CP2130::Transport::isCompletionThread() const
+{
+    return false;
+}
+
+// Submits a bulk transfer, by default performing it synchronously and then invoking the callback
+void CP2130::Transport::submitBulkTransfer(uint8_t endpointAddr, unsigned char *data, int length, TransferCallback callback, void *userData)
+{
+    int transferred = 0;
+    int result = bulkTransfer(endpointAddr, data, length, &transferred);
+    callback(transportResult(result, transferred), userData);
+}
+
+// Submits a control transfer, by default performing it synchronously and then invoking the callback
+void CP2130::Transport::submitControlTransfer(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength, TransferCallback callback, void *userData)
+{
+    int result = controlTransfer(bmRequestType, bRequest, wValue, wIndex, data, wLength);
+    callback(transportResult(result, result), userData);
+}
+
+// Destructor of TransferObserver, which only exists so that implementations can be deleted through a base pointer
+CP2130::TransferObserver::~TransferObserver()
+{
 }
 
 // "Equal to" operator for EventCounter
@@ -199,14 +670,25 @@ bool CP2130::USBConfig::operator !=(const CP2130::USBConfig &other) const
 CP2130::CP2130() :
     context_(nullptr),
     handle_(nullptr),
+    transport_(nullptr),
+    observer_(nullptr),
+    kernelWasAttached_(false),
     disconnected_(false),
-    kernelWasAttached_(false)
+    stopEvents_(false),
+    stopRTR_(false),
+    rtrEndpointAddr_(0),
+    pendingTransfers_(0),
+    profileEnabled_(false),
+    profileValid_(false),
+    profile_(new Profile),
+    spiBuffer_(2 * SPI_BUFFER_SIZE)  // Two slots, so that spiWriteRead() can prepare the next chunk while the current one is in flight
 {
 }
 
 CP2130::~CP2130()
 {
     close();  // The destructor is used to close the device, and this is essential so the device can be freed when the parent object is destroyed
+    delete profile_;
 }
 
 // Diagnostic function used to verify if the device has been disconnected
@@ -218,52 +700,72 @@ bool CP2130::disconnected() const
 // Checks if the device is open
 bool CP2130::isOpen() const
 {
-    return handle_ != nullptr;  // Returns true if the device is open, or false otherwise
+    return handle_ != nullptr || transport_ != nullptr;  // Returns true if the device is open, or false otherwise
+}
+
+// Checks if the device profile is enabled, that is, if it is fetched when the device is opened (added in version 1.3.0)
+bool CP2130::isProfileEnabled() const
+{
+    return profileEnabled_;
+}
+
+// Checks if the device profile is valid, in which case the accessors serve from it instead of querying the device (added in version 1.3.0)
+bool CP2130::isProfileValid() const
+{
+    return profileValid_;
 }
 
 // Safe bulk transfer
+// This is a blocking wrapper over submitBulkTransfer()
 void CP2130::bulkTransfer(uint8_t endpointAddr, unsigned char *data, int length, int *transferred, int &errcnt, std::string &errstr)
 {
-    if (!isOpen()) {
-        ++errcnt;
-        errstr += "In bulkTransfer(): device is not open.\n";  // Program logic error
-    } else {
-        int result = libusb_bulk_transfer(handle_, endpointAddr, data, length, transferred, TR_TIMEOUT);
-        if (result != 0 || (transferred != nullptr && *transferred != length)) {  // The number of transferred bytes is also verified, as long as a valid (non-null) pointer is passed via "transferred"
-            ++errcnt;
-            std::ostringstream stream;
-            if (endpointAddr < 0x80) {
-                stream << "Failed bulk OUT transfer to endpoint "
-                       << (0x0f & endpointAddr)
-                       << " (address 0x"
-                       << std::hex << std::setfill ('0') << std::setw(2) << static_cast<int>(endpointAddr)
-                       << ")." << std::endl;
-            } else {
-                stream << "Failed bulk IN transfer from endpoint "
-                       << (0x0f & endpointAddr)
-                       << " (address 0x"
-                       << std::hex << std::setfill ('0') << std::setw(2) << static_cast<int>(endpointAddr)
-                       << ")." << std::endl;
-            }
-            errstr += stream.str();
-            if (result == LIBUSB_ERROR_NO_DEVICE || result == LIBUSB_ERROR_IO) {  // Note that libusb_bulk_transfer() may return "LIBUSB_ERROR_IO" [-1] on device disconnect
-                disconnected_ = true;  // This reports that the device has been disconnected
-            }
-        }
-    }
+    bulkTransferGeneric(endpointAddr, bulkRequest(endpointAddr, data, length), data, length, transferred, errcnt, errstr);
+}
+
+// Submits a bulk transfer without waiting for it to complete, and returns a future that becomes ready once it does (added in version 1.3.0)
+// The given buffer must remain valid until then
+std::future<CP2130::TransferResult> CP2130::bulkTransferAsync(uint8_t endpointAddr, unsigned char *data, int length, int &errcnt, std::string &errstr)
+{
+    std::promise<TransferResult> *promise = new std::promise<TransferResult>;  // Deleted by fulfilPromise()
+    std::future<TransferResult> future = promise->get_future();
+    submitBulkTransfer(endpointAddr, data, length, fulfilPromise, promise, errcnt, errstr);
+    return future;
 }
 
 // Closes the device safely, if open
 void CP2130::close()
 {
+    profileValid_ = false;  // The device profile is only valid while the device is open
     if (isOpen()) {  // This condition avoids a segmentation fault if the calling algorithm tries, for some reason, to close the same device twice (e.g., if the device is already closed when the destructor is called)
-        libusb_release_interface(handle_, 0);  // Release the interface
-        if (kernelWasAttached_) {  // If a kernel driver was attached to the interface before
-            libusb_attach_kernel_driver(handle_, 0);  // Reattach the kernel driver
+        {
+            std::unique_lock<std::mutex> lock(transferMutex_);
+            while (pendingTransfers_ > 0) {  // Transfers still in flight are allowed to complete (or to time out) before the device is released
+                transferCondition_.wait(lock);
+            }
+        }
+        if (transport_ == nullptr) {
+            stopEvents_ = true;
+#if LIBUSB_API_VERSION >= 0x01000105
+            libusb_interrupt_event_handler(context_);  // Wake up the event handling thread, so that it stops immediately
+#endif
+            eventThread_.join();
+        }
+        for (size_t i = 0; i < freeTransfers_.size(); ++i) {
+            libusb_free_transfer(freeTransfers_[i]->transfer);  // Note that libusb_free_transfer() has no effect on the null pointer held by transfers done through a custom transport
+            delete freeTransfers_[i];
+        }
+        freeTransfers_.clear();
+        if (transport_ != nullptr) {  // Custom transports hold no resources on behalf of this object
+            transport_ = nullptr;
+        } else {
+            libusb_release_interface(handle_, 0);  // Release the interface
+            if (kernelWasAttached_) {  // If a kernel driver was attached to the interface before
+                libusb_attach_kernel_driver(handle_, 0);  // Reattach the kernel driver
+            }
+            libusb_close(handle_);  // Close the device
+            libusb_exit(context_);  // Deinitialize libusb
+            handle_ = nullptr;  // Required to mark the device as closed
         }
-        libusb_close(handle_);  // Close the device
-        libusb_exit(context_);  // Deinitialize libusb
-        handle_ = nullptr;  // Required to mark the device as closed
     }
 }
 
@@ -298,7 +800,11 @@ void CP2130::configureSPIDelays(uint8_t channel, const SPIDelays &delays, int &e
             static_cast<uint8_t>(delays.pstastdly >> 8), static_cast<uint8_t>(delays.pstastdly),                         // Post-assert delay
             static_cast<uint8_t>(delays.prdastdly >> 8), static_cast<uint8_t>(delays.prdastdly)                          // Pre-deassert delay
         };
+        int preverrcnt = errcnt;
         controlTransfer(SET, SET_SPI_DELAY, 0x0000, 0x0000, controlBufferOut, SET_SPI_DELAY_WLEN, errcnt, errstr);
+        if (profileValid_ && errcnt == preverrcnt) {  // The device profile is kept up to date
+            profile_->spiDelays[channel] = delays;
+        }
     }
 }
 
@@ -313,34 +819,55 @@ void CP2130::configureSPIMode(uint8_t channel, const SPIMode &mode, int &errcnt,
             channel,                                                                                       // Selected channel
             static_cast<uint8_t>(mode.cpha << 5 | mode.cpol << 4 | mode.csmode << 3 | (0x07 & mode.cfrq))  // Control word (specified chip select mode, clock frequency, polarity and phase)
         };
+        int preverrcnt = errcnt;
         controlTransfer(SET, SET_SPI_WORD, 0x0000, 0x0000, controlBufferOut, SET_SPI_WORD_WLEN, errcnt, errstr);
+        if (profileValid_ && errcnt == preverrcnt) {  // The device profile is kept up to date
+            profile_->spiModes[channel] = mode;
+            profile_->spiModes[channel].cfrq = static_cast<uint8_t>(0x07 & mode.cfrq);  // As written to the control word
+        }
     }
 }
 
 // Safe control transfer
+// This is a blocking wrapper over submitControlTransfer()
 void CP2130::controlTransfer(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength, int &errcnt, std::string &errstr)
 {
     if (!isOpen()) {
         ++errcnt;
         errstr += "In controlTransfer(): device is not open.\n";  // Program logic error
     } else {
-        int result = libusb_control_transfer(handle_, bmRequestType, bRequest, wValue, wIndex, data, wLength, TR_TIMEOUT);
-        if (result != wLength) {
-            ++errcnt;
-            std::ostringstream stream;
-            stream << "Failed control transfer (0x"
-                   << std::hex << std::setfill ('0') << std::setw(2) << static_cast<int>(bmRequestType)
-                   << ", 0x"
-                   << std::setw(2) << static_cast<int>(bRequest)
-                   << ")." << std::endl;
-            errstr += stream.str();
-            if (result == LIBUSB_ERROR_NO_DEVICE || result == LIBUSB_ERROR_IO || result == LIBUSB_ERROR_PIPE) {  // Note that libusb_control_transfer() may return "LIBUSB_ERROR_IO" [-1] or "LIBUSB_ERROR_PIPE" [-9] on device disconnect
-                disconnected_ = true;  // This reports that the device has been disconnected
+        int result;
+        if (onCompletionThread()) {  // Same as above
+            int64_t start = observer_ != nullptr ? observer_->timestamp() : 0;
+            if (transport_ != nullptr) {
+                result = transport_->controlTransfer(bmRequestType, bRequest, wValue, wIndex, data, wLength);
+            } else {
+                result = libusb_control_transfer(handle_, bmRequestType, bRequest, wValue, wIndex, data, wLength, TR_TIMEOUT);
             }
+            observeTransfer(TRANSFER_CONTROL, bRequest, wLength, result == wLength, start);
+        } else {  // Same as above
+            Completion completion;
+            completion.done = false;
+            submitControlTransfer(bmRequestType, bRequest, wValue, wIndex, data, wLength, signalCompletion, &completion, errcnt, errstr);
+            TransferResult transferResult = waitCompletion(completion);
+            result = transferResult.status == LIBUSB_TRANSFER_COMPLETED ? transferResult.transferred : transferError(transferResult);  // Same semantics as the value returned by libusb_control_transfer()
+        }
+        if (result != wLength) {
+            controlTransferFailed(bmRequestType, bRequest, result, errcnt, errstr);
         }
     }
 }
 
+// Submits a control transfer without waiting for it to complete, and returns a future that becomes ready once it does (added in version 1.3.0)
+// In the case of a Device-to-Host request, the given buffer must remain valid until then
+std::future<CP2130::TransferResult> CP2130::controlTransferAsync(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength, int &errcnt, std::string &errstr)
+{
+    std::promise<TransferResult> *promise = new std::promise<TransferResult>;  // Deleted by fulfilPromise()
+    std::future<TransferResult> future = promise->get_future();
+    submitControlTransfer(bmRequestType, bRequest, wValue, wIndex, data, wLength, fulfilPromise, promise, errcnt, errstr);
+    return future;
+}
+
 // Disables the chip select of the target channel
 void CP2130::disableCS(uint8_t channel, int &errcnt, std::string &errstr)
 {
@@ -370,7 +897,11 @@ void CP2130::disableSPIDelays(uint8_t channel, int &errcnt, std::string &errstr)
             0x00, 0x00,  // post-assert and
             0x00, 0x00   // pre-deassert delays all set to 0us
         };
+        int preverrcnt = errcnt;
         controlTransfer(SET, SET_SPI_DELAY, 0x0000, 0x0000, controlBufferOut, SET_SPI_DELAY_WLEN, errcnt, errstr);
+        if (profileValid_ && errcnt == preverrcnt) {  // The device profile is kept up to date
+            profile_->spiDelays[channel] = {false, false, false, false, 0x0000, 0x0000, 0x0000};
+        }
     }
 }
 
@@ -389,6 +920,17 @@ void CP2130::enableCS(uint8_t channel, int &errcnt, std::string &errstr)
     }
 }
 
+// Gets the native handle of the event handling thread, from which the callbacks of asynchronous transfers are invoked, so that it can be given the same real-time settings as the thread that submits them (added in version 1.3.0)
+// Returns false if the device is not open, or if a custom transport is used, since its completion thread is not managed by the object
+bool CP2130::eventThreadHandle(pthread_t &handle)
+{
+    bool running = transport_ == nullptr && eventThread_.joinable();
+    if (running) {
+        handle = eventThread_.native_handle();
+    }
+    return running;
+}
+
 // Returns the current clock divider value
 uint8_t CP2130::getClockDivider(int &errcnt, std::string &errstr)
 {
@@ -530,38 +1072,27 @@ uint16_t CP2130::getLockWord(int &errcnt, std::string &errstr)
 // Gets the manufacturer descriptor from the CP2130 OTP ROM
 std::u16string CP2130::getManufacturerDesc(int &errcnt, std::string &errstr)
 {
-    return getDescGeneric(GET_MANUFACTURING_STRING_1, errcnt, errstr);
+    return profileValid_ ? profile_->manufacturer : getDescGeneric(GET_MANUFACTURING_STRING_1, errcnt, errstr);  // Served from the device profile, if valid
 }
 
 // Gets the pin configuration from the CP2130 OTP ROM
 CP2130::PinConfig CP2130::getPinConfig(int &errcnt, std::string &errstr)
 {
-    unsigned char controlBufferIn[GET_PIN_CONFIG_WLEN];
-    controlTransfer(GET, GET_PIN_CONFIG, 0x0000, 0x0000, controlBufferIn, GET_PIN_CONFIG_WLEN, errcnt, errstr);
     PinConfig config;
-    config.gpio0 = controlBufferIn[0];                                                         // GPIO.0 pin config corresponds to byte 0
-    config.gpio1 = controlBufferIn[1];                                                         // GPIO.1 pin config corresponds to byte 1
-    config.gpio2 = controlBufferIn[2];                                                         // GPIO.2 pin config corresponds to byte 2
-    config.gpio3 = controlBufferIn[3];                                                         // GPIO.3 pin config corresponds to byte 3
-    config.gpio4 = controlBufferIn[4];                                                         // GPIO.4 pin config corresponds to byte 4
-    config.gpio5 = controlBufferIn[5];                                                         // GPIO.5 pin config corresponds to byte 5
-    config.gpio6 = controlBufferIn[6];                                                         // GPIO.6 pin config corresponds to byte 6
-    config.gpio7 = controlBufferIn[7];                                                         // GPIO.7 pin config corresponds to byte 7
-    config.gpio8 = controlBufferIn[8];                                                         // GPIO.8 pin config corresponds to byte 8
-    config.gpio9 = controlBufferIn[9];                                                         // GPIO.9 pin config corresponds to byte 9
-    config.gpio10 = controlBufferIn[10];                                                       // GPIO.10 pin config corresponds to byte 10
-    config.sspndlvl = static_cast<uint16_t>(controlBufferIn[11] << 8 | controlBufferIn[12]);   // Suspend pin level bitmap corresponds to bytes 11 and 12 (big-endian conversion)
-    config.sspndmode = static_cast<uint16_t>(controlBufferIn[13] << 8 | controlBufferIn[14]);  // Suspend pin mode bitmap corresponds to bytes 13 and 14 (big-endian conversion)
-    config.wkupmask = static_cast<uint16_t>(controlBufferIn[15] << 8 | controlBufferIn[16]);   // Wakeup pin mask bitmap corresponds to bytes 15 and 16 (big-endian conversion)
-    config.wkupmatch = static_cast<uint16_t>(controlBufferIn[17] << 8 | controlBufferIn[18]);  // Wakeup pin match bitmap corresponds to bytes 17 and 18 (big-endian conversion)
-    config.divider = controlBufferIn[19];                                                      // Clock divider corresponds to byte 19
+    if (profileValid_) {  // Served from the device profile, if valid
+        config = profile_->pinConfig;
+    } else {
+        unsigned char controlBufferIn[GET_PIN_CONFIG_WLEN];
+        controlTransfer(GET, GET_PIN_CONFIG, 0x0000, 0x0000, controlBufferIn, GET_PIN_CONFIG_WLEN, errcnt, errstr);
+        config = parsePinConfig(controlBufferIn);
+    }
     return config;
 }
 
 // Gets the product descriptor from the CP2130 OTP ROM
 std::u16string CP2130::getProductDesc(int &errcnt, std::string &errstr)
 {
-    return getDescGeneric(GET_PRODUCT_STRING_1, errcnt, errstr);
+    return profileValid_ ? profile_->product : getDescGeneric(GET_PRODUCT_STRING_1, errcnt, errstr);  // Served from the device profile, if valid
 }
 
 // Gets the entire CP2130 OTP ROM content as a structure of eight 64-byte blocks
@@ -581,17 +1112,20 @@ CP2130::PROMConfig CP2130::getPROMConfig(int &errcnt, std::string &errstr)
 // Gets the serial descriptor from the CP2130 OTP ROM
 std::u16string CP2130::getSerialDesc(int &errcnt, std::string &errstr)
 {
-    return getDescGeneric(GET_SERIAL_STRING, errcnt, errstr);
+    return profileValid_ ? profile_->serial : getDescGeneric(GET_SERIAL_STRING, errcnt, errstr);  // Served from the device profile, if valid
 }
 
 // Returns the CP2130 silicon, read-only version
 CP2130::SiliconVersion CP2130::getSiliconVersion(int &errcnt, std::string &errstr)
 {
-    unsigned char controlBufferIn[GET_READONLY_VERSION_WLEN];
-    controlTransfer(GET, GET_READONLY_VERSION, 0x0000, 0x0000, controlBufferIn, GET_READONLY_VERSION_WLEN, errcnt, errstr);
     SiliconVersion version;
-    version.maj = controlBufferIn[0];  // Major read-only version corresponds to byte 0
-    version.min = controlBufferIn[1];  // Minor read-only version corresponds to byte 1
+    if (profileValid_) {  // Served from the device profile, if valid
+        version = profile_->siliconVersion;
+    } else {
+        unsigned char controlBufferIn[GET_READONLY_VERSION_WLEN];
+        controlTransfer(GET, GET_READONLY_VERSION, 0x0000, 0x0000, controlBufferIn, GET_READONLY_VERSION_WLEN, errcnt, errstr);
+        version = parseSiliconVersion(controlBufferIn);
+    }
     return version;
 }
 
@@ -603,16 +1137,12 @@ CP2130::SPIDelays CP2130::getSPIDelays(uint8_t channel, int &errcnt, std::string
         ++errcnt;
         errstr += "In getSPIDelays(): SPI channel value must be between 0 and 10.\n";  // Program logic error
         delays = {false, false, false, false, 0x0000, 0x0000, 0x0000};
+    } else if (profileValid_) {  // Served from the device profile, if valid
+        delays = profile_->spiDelays[channel];
     } else {
         unsigned char controlBufferIn[GET_SPI_DELAY_WLEN];
         controlTransfer(GET, GET_SPI_DELAY, 0x0000, channel, controlBufferIn, GET_SPI_DELAY_WLEN, errcnt, errstr);  // The value of "channel" is now passed to "wIndex" in controlTransfer(), as it should (fixed in version 1.2.5)
-        delays.cstglen = (0x08 & controlBufferIn[1]) != 0x00;                                    // CS toggle enable corresponds to bit 3 of byte 1
-        delays.prdasten = (0x04 & controlBufferIn[1]) != 0x00;                                   // Pre-deassert delay enable corresponds to bit 2 of byte 1
-        delays.pstasten = (0x02 & controlBufferIn[1]) != 0x00;                                   // Post-assert delay enable to bit 1 of byte 1
-        delays.itbyten = (0x01 &controlBufferIn[1]) != 0x00;                                     // Inter-byte delay enable corresponds to bit 0 of byte 1
-        delays.itbytdly = static_cast<uint16_t>(controlBufferIn[2] << 8 | controlBufferIn[3]);   // Inter-byte delay corresponds to bytes 2 and 3 (big-endian conversion)
-        delays.pstastdly = static_cast<uint16_t>(controlBufferIn[4] << 8 | controlBufferIn[5]);  // Post-assert delay corresponds to bytes 4 and 5 (big-endian conversion)
-        delays.prdastdly = static_cast<uint16_t>(controlBufferIn[6] << 8 | controlBufferIn[7]);  // Pre-deassert delay corresponds to bytes 6 and 7 (big-endian conversion)
+        delays = parseSPIDelays(controlBufferIn);
     }
     return delays;
 }
@@ -625,13 +1155,12 @@ CP2130::SPIMode CP2130::getSPIMode(uint8_t channel, int &errcnt, std::string &er
         ++errcnt;
         errstr += "In getSPIMode(): SPI channel value must be between 0 and 10.\n";  // Program logic error
         mode = {false, 0x00, false, false};
+    } else if (profileValid_) {  // Served from the device profile, if valid
+        mode = profile_->spiModes[channel];
     } else {
         unsigned char controlBufferIn[GET_SPI_WORD_WLEN];
         controlTransfer(GET, GET_SPI_WORD, 0x0000, 0x0000, controlBufferIn, GET_SPI_WORD_WLEN, errcnt, errstr);
-        mode.csmode = (0x08 & controlBufferIn[channel]) != 0x00;            // Chip select mode corresponds to bit 3
-        mode.cfrq = static_cast<uint8_t>(0x07 & controlBufferIn[channel]);  // Clock frequency is set in the bits 2:0
-        mode.cpha = (0x20 & controlBufferIn[channel]) != 0x00;              // Clock phase corresponds to bit 5
-        mode.cpol = (0x10 &controlBufferIn[channel]) != 0x00;               // Clock polarity corresponds to bit 4
+        mode = parseSPIMode(controlBufferIn, channel);
     }
     return mode;
 }
@@ -645,19 +1174,24 @@ uint8_t CP2130::getTransferPriority(int &errcnt, std::string &errstr)
 // Gets the USB configuration, including VID, PID, major and minor release versions, from the CP2130 OTP ROM
 CP2130::USBConfig CP2130::getUSBConfig(int &errcnt, std::string &errstr)
 {
-    unsigned char controlBufferIn[GET_USB_CONFIG_WLEN];
-    controlTransfer(GET, GET_USB_CONFIG, 0x0000, 0x0000, controlBufferIn, GET_USB_CONFIG_WLEN, errcnt, errstr);
     USBConfig config;
-    config.vid = static_cast<uint16_t>(controlBufferIn[1] << 8 | controlBufferIn[0]);  // VID corresponds to bytes 0 and 1 (little-endian conversion)
-    config.pid = static_cast<uint16_t>(controlBufferIn[3] << 8 | controlBufferIn[2]);  // PID corresponds to bytes 2 and 3 (little-endian conversion)
-    config.majrel = controlBufferIn[6];                                                // Major release version corresponds to byte 6
-    config.minrel = controlBufferIn[7];                                                // Minor release version corresponds to byte 7
-    config.maxpow = controlBufferIn[4];                                                // Maximum power consumption corresponds to byte 4
-    config.powmode = controlBufferIn[5];                                               // Power mode corresponds to byte 5
-    config.trfprio = controlBufferIn[8];                                               // Transfer priority corresponds to byte 8
+    if (profileValid_) {  // Served from the device profile, if valid, which also spares getEndpointInAddr() and getEndpointOutAddr() from any transfers
+        config = profile_->usbConfig;
+    } else {
+        unsigned char controlBufferIn[GET_USB_CONFIG_WLEN];
+        controlTransfer(GET, GET_USB_CONFIG, 0x0000, 0x0000, controlBufferIn, GET_USB_CONFIG_WLEN, errcnt, errstr);
+        config = parseUSBConfig(controlBufferIn);
+    }
     return config;
 }
 
+// Invalidates the device profile, so that the accessors query the device again until the profile is refreshed (added in version 1.3.0)
+// This is done automatically when writing to the OTP ROM or resetting the device, but should also be done if the device is reconfigured by other means
+void CP2130::invalidateProfile()
+{
+    profileValid_ = false;
+}
+
 // Returns true is the OTP ROM of the CP2130 was never written
 bool CP2130::isOTPBlank(int &errcnt, std::string &errstr)
 {
@@ -722,6 +1256,13 @@ int CP2130::open(uint16_t vid, uint16_t pid, const std::string &serial)
                 retval = ERROR_BUSY;
             } else {
                 disconnected_ = false;  // Note that this flag is never assumed to be true for a device that was never opened - See constructor for details!
+                stopEvents_ = false;
+                eventThread_ = std::thread(&CP2130::handleEvents, this);  // Asynchronous transfers are completed by a dedicated thread
+                if (profileEnabled_) {  // If enabled, the device profile is fetched once
+                    int errcnt = 0;
+                    std::string errstr;
+                    refreshProfile(errcnt, errstr);  // Errors are not fatal, since the accessors query the device as long as the profile is not valid
+                }
                 retval = SUCCESS;
             }
         }
@@ -729,10 +1270,90 @@ int CP2130::open(uint16_t vid, uint16_t pid, const std::string &serial)
     return retval;
 }
 
+// Opens a device through the given transport, instead of libusb (added in version 1.3.0)
+// The transport must remain valid until the device is closed, and asynchronous transfers are submitted to it, so that their callbacks are invoked from its completion thread, if any
+int CP2130::open(Transport &transport)
+{
+    if (!isOpen()) {  // As above, opening an already open device has no effect
+        transport_ = &transport;
+        disconnected_ = false;
+        if (profileEnabled_) {  // Same as above
+            int errcnt = 0;
+            std::string errstr;
+            refreshProfile(errcnt, errstr);
+        }
+    }
+    return SUCCESS;
+}
+
+// Fetches the device profile, which is then served by the corresponding accessors, until invalidated (added in version 1.3.0)
+// Every request is submitted before any of them is waited for, so that fetching the profile takes little longer than the slowest request, instead of one round trip per request
+void CP2130::refreshProfile(int &errcnt, std::string &errstr)
+{
+    const size_t NREQUESTS = 20;  // One request for each of the USB configuration, pin configuration, silicon version and SPI control words, eleven for the SPI delays, and five for the descriptor tables
+    unsigned char usbConfigBuffer[GET_USB_CONFIG_WLEN], pinConfigBuffer[GET_PIN_CONFIG_WLEN], versionBuffer[GET_READONLY_VERSION_WLEN], spiWordBuffer[GET_SPI_WORD_WLEN];
+    unsigned char spiDelayBuffers[11][GET_SPI_DELAY_WLEN], descBuffers[5][DESC_TBLSIZE];
+    struct Request {
+        uint8_t bRequest;
+        uint16_t wIndex;
+        unsigned char *data;
+        uint16_t wLength;
+    } requests[NREQUESTS] = {
+        {GET_USB_CONFIG, 0x0000, usbConfigBuffer, GET_USB_CONFIG_WLEN},
+        {GET_PIN_CONFIG, 0x0000, pinConfigBuffer, GET_PIN_CONFIG_WLEN},
+        {GET_READONLY_VERSION, 0x0000, versionBuffer, GET_READONLY_VERSION_WLEN},
+        {GET_SPI_WORD, 0x0000, spiWordBuffer, GET_SPI_WORD_WLEN},
+        {GET_MANUFACTURING_STRING_1, 0x0000, descBuffers[0], DESC_TBLSIZE},
+        {GET_MANUFACTURING_STRING_2, 0x0000, descBuffers[1], DESC_TBLSIZE},
+        {GET_PRODUCT_STRING_1, 0x0000, descBuffers[2], DESC_TBLSIZE},
+        {GET_PRODUCT_STRING_2, 0x0000, descBuffers[3], DESC_TBLSIZE},
+        {GET_SERIAL_STRING, 0x0000, descBuffers[4], DESC_TBLSIZE}
+    };
+    for (uint8_t channel = 0; channel < 11; ++channel) {
+        requests[9 + channel] = {GET_SPI_DELAY, channel, spiDelayBuffers[channel], GET_SPI_DELAY_WLEN};
+    }
+    if (!isOpen()) {
+        ++errcnt;
+        errstr += "In refreshProfile(): device is not open.\n";  // Program logic error
+    } else if (onCompletionThread()) {
+        ++errcnt;
+        errstr += "In refreshProfile(): cannot be called from a completion callback.\n";  // Program logic error
+    } else {
+        int preverrcnt = errcnt;
+        profileValid_ = false;  // The accessors must not serve from the profile while it is being fetched
+        Completion completions[NREQUESTS];
+        for (size_t i = 0; i < NREQUESTS; ++i) {
+            completions[i].done = false;
+            submitControlTransfer(GET, requests[i].bRequest, 0x0000, requests[i].wIndex, requests[i].data, requests[i].wLength, signalCompletion, &completions[i], errcnt, errstr);
+        }
+        for (size_t i = 0; i < NREQUESTS; ++i) {  // Every transfer is waited for, even in case of error, since the buffers must remain valid until they complete
+            TransferResult transferResult = waitCompletion(completions[i]);
+            int result = transferResult.status == LIBUSB_TRANSFER_COMPLETED ? transferResult.transferred : transferError(transferResult);
+            if (result != requests[i].wLength) {
+                controlTransferFailed(GET, requests[i].bRequest, result, errcnt, errstr);
+            }
+        }
+        if (errcnt == preverrcnt) {
+            profile_->usbConfig = parseUSBConfig(usbConfigBuffer);
+            profile_->pinConfig = parsePinConfig(pinConfigBuffer);
+            profile_->siliconVersion = parseSiliconVersion(versionBuffer);
+            for (uint8_t channel = 0; channel < 11; ++channel) {
+                profile_->spiModes[channel] = parseSPIMode(spiWordBuffer, channel);
+                profile_->spiDelays[channel] = parseSPIDelays(spiDelayBuffers[channel]);
+            }
+            profile_->manufacturer = parseDescriptor(descBuffers[0], descBuffers[1]);
+            profile_->product = parseDescriptor(descBuffers[2], descBuffers[3]);
+            profile_->serial = parseDescriptor(descBuffers[4], nullptr);
+            profileValid_ = true;
+        }
+    }
+}
+
 // Issues a reset to the CP2130
 void CP2130::reset(int &errcnt, std::string &errstr)
 {
     controlTransfer(SET, RESET_DEVICE, 0x0000, 0x0000, nullptr, RESET_DEVICE_WLEN, errcnt, errstr);
+    invalidateProfile();  // SPI modes and delays revert to their defaults
 }
 
 // Enables the chip select of the target channel, disabling any others
@@ -854,117 +1475,291 @@ void CP2130::setGPIOs(uint16_t bmValues, uint16_t bmMask, int &errcnt, std::stri
     controlTransfer(SET, SET_GPIO_VALUES, 0x0000, 0x0000, controlBufferOut, SET_GPIO_VALUES_WLEN, errcnt, errstr);
 }
 
+// Enables or disables the device profile (added in version 1.3.0)
+// When enabled, the profile is fetched when the device is opened, and then served by the accessors, so that endpoint addresses, SPI modes and delays, pin and USB configurations, silicon version and descriptors cost no further transfers
+// Note that this should be done before opening the device, or else refreshProfile() should be called afterwards
+void CP2130::setProfileEnabled(bool value)
+{
+    profileEnabled_ = value;
+    if (!value) {
+        profileValid_ = false;
+    }
+}
+
+// Sets the observer to which every transfer is reported once it completes, or nullptr to stop observing transfers (added in version 1.3.0)
+// This should only be done while no asynchronous transfers are in flight
+void CP2130::setTransferObserver(TransferObserver *observer)
+{
+    observer_ = observer;
+}
+
 // Requests and reads the given number of bytes from the SPI bus, and then returns a vector
 // This is the prefered method of reading from the bus, if both endpoint addresses are known
 std::vector<uint8_t> CP2130::spiRead(uint32_t bytesToRead, uint8_t endpointInAddr, uint8_t endpointOutAddr, int &errcnt, std::string &errstr)
 {
-    unsigned char readCommandBuffer[8] = {
-        0x00, 0x00,    // Reserved
-        CP2130::READ,  // Read command
-        0x00,          // Reserved
-        static_cast<uint8_t>(bytesToRead),
-        static_cast<uint8_t>(bytesToRead >> 8),
-        static_cast<uint8_t>(bytesToRead >> 16),
-        static_cast<uint8_t>(bytesToRead >> 24)
-    };
+    std::vector<uint8_t> retdata(bytesToRead);
+    retdata.resize(spiRead(retdata.data(), bytesToRead, endpointInAddr, endpointOutAddr, errcnt, errstr));  // The data is read directly into the vector
+    return retdata;
+}
+
+// This function is a shorthand version of the previous one (both endpoint addresses are automatically deduced, at the cost of decreased speed)
+std::vector<uint8_t> CP2130::spiRead(uint32_t bytesToRead, int &errcnt, std::string &errstr)
+{
+    return spiRead(bytesToRead, getEndpointInAddr(errcnt, errstr), getEndpointOutAddr(errcnt, errstr), errcnt, errstr);
+}
+
+// Requests and reads the given number of bytes from the SPI bus directly into the given buffer, and then returns the number of bytes read (added in version 1.3.0)
+// The buffer must be able to hold "bytesToRead" bytes, and no memory is allocated, so this is the prefered method of reading from the bus repeatedly
+size_t CP2130::spiRead(uint8_t *data, uint32_t bytesToRead, uint8_t endpointInAddr, uint8_t endpointOutAddr, int &errcnt, std::string &errstr)
+{
+    std::lock_guard<std::mutex> lock(spiMutex_);
+    fillSPIHeader(spiBuffer_.data(), READ, bytesToRead);
 #if LIBUSB_API_VERSION >= 0x01000105
-    bulkTransfer(endpointOutAddr, readCommandBuffer, static_cast<int>(sizeof(readCommandBuffer)), nullptr, errcnt, errstr);
+    bulkTransfer(endpointOutAddr, spiBuffer_.data(), static_cast<int>(SPI_HEADER_SIZE), nullptr, errcnt, errstr);
 #else
     int bytesWritten;
-    bulkTransfer(endpointOutAddr, readCommandBuffer, static_cast<int>(sizeof(readCommandBuffer)), &bytesWritten, errcnt, errstr);
+    bulkTransfer(endpointOutAddr, spiBuffer_.data(), static_cast<int>(SPI_HEADER_SIZE), &bytesWritten, errcnt, errstr);
 #endif
-    unsigned char *readInputBuffer = new unsigned char[bytesToRead];  // Allocated dynamically since version 1.1.0
     int bytesRead = 0;  // Important!
-    bulkTransfer(endpointInAddr, readInputBuffer, static_cast<int>(bytesToRead), &bytesRead, errcnt, errstr);
-    std::vector<uint8_t> retdata(static_cast<size_t>(bytesRead));
-    for (int i = 0; i < bytesRead; ++i) {
-        retdata[i] = readInputBuffer[i];
+    bulkTransfer(endpointInAddr, data, static_cast<int>(bytesToRead), &bytesRead, errcnt, errstr);
+    return static_cast<size_t>(bytesRead);
+}
+
+// Starts a ReadWithRTR command, and then streams the data read from the SPI bus to the given callback, as it arrives (added in version 1.3.0)
+// Several IN transfers are kept queued, so that the bridge never waits for the host while RTR is active, and the callback is invoked from the calling thread, in order
+// Streaming goes on until the given number of bytes is read, an error occurs, or stopRTR() is called, either from another thread or from the callback, and the number of bytes read is returned
+// Streaming also ends with an error if RTR stays inactive while several IN transfers in a row time out
+// Note that the bridge cannot process other SPI commands in the meantime, and that the callback is invoked while holding the lock that serializes SPI functions, so the callback must not call any SPI function other than stopRTR(), or it will deadlock
+size_t CP2130::spiReadWithRTR(uint32_t bytesToRead, SPIDataCallback callback, void *userData, uint8_t endpointInAddr, uint8_t endpointOutAddr, int &errcnt, std::string &errstr)
+{
+    size_t bytesRead = 0;
+    if (onCompletionThread()) {
+        ++errcnt;
+        errstr += "In spiReadWithRTR(): cannot be called from a completion callback.\n";  // Program logic error
+    } else {
+        stopRTR_ = false;  // Cleared before waiting for any other SPI function to return, so that a stopRTR() call made in the meantime is not lost
+        std::lock_guard<std::mutex> lock(spiMutex_);
+        fillSPIHeader(spiBuffer_.data(), READWITHRTR, bytesToRead);
+        int preverrcnt = errcnt;
+        int bytesWritten = 0;
+        bulkTransfer(endpointOutAddr, spiBuffer_.data(), static_cast<int>(SPI_HEADER_SIZE), &bytesWritten, errcnt, errstr);
+        if (errcnt == preverrcnt) {
+            rtrEndpointAddr_ = endpointInAddr;  // From now on, IN transfers to this endpoint can be cancelled by stopRTR()
+            std::vector<unsigned char> buffer(RTR_QUEUE_DEPTH * RTR_TRANSFER_SIZE);  // One slot per queued transfer
+            Completion completions[RTR_QUEUE_DEPTH];
+            size_t lengths[RTR_QUEUE_DEPTH];
+            size_t head = 0, nPending = 0;  // Transfers complete in the order they were submitted, so the slots are used as a ring
+            size_t bytesRequested = 0;  // Bytes requested by all transfers that were submitted, not counting those that they failed to read
+            int timeouts = 0;  // Number of consecutive IN transfers that timed out without reading any data
+            bool failed = false;
+            while (true) {
+                while (!failed && !stopRTR_ && nPending < RTR_QUEUE_DEPTH && bytesRequested < bytesToRead) {  // The queue is topped up, unless streaming is about to end
+                    size_t slot = (head + nPending) % RTR_QUEUE_DEPTH;
+                    lengths[slot] = bytesToRead - bytesRequested;
+                    if (lengths[slot] > RTR_TRANSFER_SIZE) {
+                        lengths[slot] = RTR_TRANSFER_SIZE;
+                    }
+                    completions[slot].done = false;
+                    submitBulkTransfer(endpointInAddr, buffer.data() + slot * RTR_TRANSFER_SIZE, static_cast<int>(lengths[slot]), signalCompletion, &completions[slot], errcnt, errstr);
+                    bytesRequested += lengths[slot];
+                    ++nPending;
+                }
+                if (nPending == 0) {
+                    break;
+                }
+                TransferResult result = waitCompletion(completions[head]);
+                int error = transferError(result);
+                timeouts = error == LIBUSB_ERROR_TIMEOUT && result.transferred == 0 ? timeouts + 1 : 0;
+                if (error == LIBUSB_ERROR_INTERRUPTED && stopRTR_) {  // Transfers cancelled by stopRTR() are not an error, although they may still have read some data
+                    error = LIBUSB_SUCCESS;
+                } else if (error == LIBUSB_ERROR_TIMEOUT && timeouts < RTR_TIMEOUTS_MAX) {  // A timeout only means that RTR was not active long enough to fill the transfer, so any data received is still valid
+                    error = LIBUSB_SUCCESS;
+                }
+                if (error != 0) {
+                    if (!failed) {
+                        bulkTransferFailed(endpointInAddr, error, errcnt, errstr);
+                        failed = true;  // The remaining transfers are still waited for, since their buffers must remain valid until they complete
+                    }
+                } else if (!failed && result.transferred > 0) {
+                    callback(buffer.data() + head * RTR_TRANSFER_SIZE, static_cast<size_t>(result.transferred), userData);
+                    bytesRead += static_cast<size_t>(result.transferred);
+                }
+                bytesRequested -= lengths[head] - static_cast<size_t>(result.transferred);  // Bytes that were not read are requested again by a later transfer
+                head = (head + 1) % RTR_QUEUE_DEPTH;
+                --nPending;
+            }
+            rtrEndpointAddr_ = 0;
+        }
     }
-    delete[] readInputBuffer;
-    return retdata;
+    return bytesRead;
 }
 
 // This function is a shorthand version of the previous one (both endpoint addresses are automatically deduced, at the cost of decreased speed)
-std::vector<uint8_t> CP2130::spiRead(uint32_t bytesToRead, int &errcnt, std::string &errstr)
+size_t CP2130::spiReadWithRTR(uint32_t bytesToRead, SPIDataCallback callback, void *userData, int &errcnt, std::string &errstr)
 {
-    return spiRead(bytesToRead, getEndpointInAddr(errcnt, errstr), getEndpointOutAddr(errcnt, errstr), errcnt, errstr);
+    return spiReadWithRTR(bytesToRead, callback, userData, getEndpointInAddr(errcnt, errstr), getEndpointOutAddr(errcnt, errstr), errcnt, errstr);
 }
 
 // Writes to the SPI bus, using the given vector
 // This is the prefered method of writing to the bus, if the endpoint OUT address is known
 void CP2130::spiWrite(const std::vector<uint8_t> &data, uint8_t endpointOutAddr, int &errcnt, std::string &errstr)
 {
-    uint32_t bytesToWrite = static_cast<uint32_t>(data.size());
-    int bufSize = bytesToWrite + 8;
-    unsigned char *writeCommandBuffer = new unsigned char[bufSize] {  // Allocated dynamically since version 1.1.0
-        0x00, 0x00,     // Reserved
-        CP2130::WRITE,  // Write command
-        0x00,           // Reserved
-        static_cast<uint8_t>(bytesToWrite),
-        static_cast<uint8_t>(bytesToWrite >> 8),
-        static_cast<uint8_t>(bytesToWrite >> 16),
-        static_cast<uint8_t>(bytesToWrite >> 24)
-    };
-    for (size_t i = 0; i < bytesToWrite; ++i) {
-        writeCommandBuffer[i + 8] = data[i];
-    }
+    spiWrite(data.data(), data.size(), endpointOutAddr, errcnt, errstr);
+}
+
+// This function is a shorthand version of the previous one (the endpoint OUT address is automatically deduced at the cost of decreased speed)
+void CP2130::spiWrite(const std::vector<uint8_t> &data, int &errcnt, std::string &errstr)
+{
+    spiWrite(data, getEndpointOutAddr(errcnt, errstr), errcnt, errstr);
+}
+
+// Writes the given number of bytes to the SPI bus, using the given buffer (added in version 1.3.0)
+// Data that fits in a single packet along with the command header is copied into a buffer owned by the object, so that writing short frames does not allocate memory, while longer data is streamed by spiWriteStream()
+void CP2130::spiWrite(const uint8_t *data, size_t bytesToWrite, uint8_t endpointOutAddr, int &errcnt, std::string &errstr)
+{
+    if (bytesToWrite > SPI_BUFFER_SIZE - SPI_HEADER_SIZE) {
+        spiWriteStream(data, bytesToWrite, SPI_STREAM_DEPTH_DEFAULT, endpointOutAddr, errcnt, errstr);
+    } else {
+        std::lock_guard<std::mutex> lock(spiMutex_);
+        size_t bufSize = SPI_HEADER_SIZE + bytesToWrite;
+        fillSPIHeader(spiBuffer_.data(), WRITE, static_cast<uint32_t>(bytesToWrite));
+        if (bytesToWrite > 0) {
+            std::memcpy(spiBuffer_.data() + SPI_HEADER_SIZE, data, bytesToWrite);
+        }
 #if LIBUSB_API_VERSION >= 0x01000105
-    bulkTransfer(endpointOutAddr, writeCommandBuffer, bufSize, nullptr, errcnt, errstr);
+        bulkTransfer(endpointOutAddr, spiBuffer_.data(), static_cast<int>(bufSize), nullptr, errcnt, errstr);
 #else
-    int bytesWritten;
-    bulkTransfer(endpointOutAddr, writeCommandBuffer, bufSize, &bytesWritten, errcnt, errstr);
+        int bytesWritten;
+        bulkTransfer(endpointOutAddr, spiBuffer_.data(), static_cast<int>(bufSize), &bytesWritten, errcnt, errstr);
 #endif
-    delete[] writeCommandBuffer;
+    }
+}
+
+// Writes the given number of bytes to the SPI bus under a single Write command, while keeping up to "depth" bulk transfers in flight (added in version 1.3.0)
+// The command header is sent along with the first bytes of data, so that both fill exactly one packet, and the remaining data is sent directly from the given buffer, in pieces whose size is a multiple of the maximum packet size
+// Since the data is neither copied nor split into several commands, this is the prefered method of writing long streams, such as frequency or phase tables
+void CP2130::spiWriteStream(const uint8_t *data, size_t bytesToWrite, size_t depth, uint8_t endpointOutAddr, int &errcnt, std::string &errstr)
+{
+    if (depth < 1 || depth > SPI_STREAM_DEPTH_MAX) {
+        ++errcnt;
+        errstr += "In spiWriteStream(): Depth must be between 1 and 8.\n";  // Program logic error
+    } else {
+        std::lock_guard<std::mutex> lock(spiMutex_);
+        size_t headSize = SPI_BUFFER_SIZE - SPI_HEADER_SIZE;  // Number of bytes sent along with the command header
+        if (bytesToWrite < headSize) {
+            headSize = bytesToWrite;
+        }
+        fillSPIHeader(spiBuffer_.data(), WRITE, static_cast<uint32_t>(bytesToWrite));
+        if (headSize > 0) {
+            std::memcpy(spiBuffer_.data() + SPI_HEADER_SIZE, data, headSize);
+        }
+        size_t nPieces = 1 + (bytesToWrite - headSize + SPI_STREAM_PIECE_SIZE - 1) / SPI_STREAM_PIECE_SIZE;
+        bool pipelined = !onCompletionThread();  // If called from a completion callback, the pieces are written one at a time, since waiting for the event handling thread is not possible
+        Completion completions[SPI_STREAM_DEPTH_MAX];
+        int lengths[SPI_STREAM_DEPTH_MAX];
+        size_t head = 0, nPending = 0, nextPiece = 0;  // Transfers complete in the order they were submitted, so the slots are used as a ring
+        int preverrcnt = errcnt;
+        while (true) {
+            while (nextPiece < nPieces && nPending < depth && preverrcnt == errcnt) {  // No further pieces are submitted in case of error
+                size_t slot = (head + nPending) % depth;
+                unsigned char *piece;
+                if (nextPiece == 0) {
+                    piece = spiBuffer_.data();
+                    lengths[slot] = static_cast<int>(SPI_HEADER_SIZE + headSize);
+                } else {
+                    size_t offset = headSize + (nextPiece - 1) * SPI_STREAM_PIECE_SIZE;
+                    size_t pieceSize = bytesToWrite - offset;
+                    if (pieceSize > SPI_STREAM_PIECE_SIZE) {
+                        pieceSize = SPI_STREAM_PIECE_SIZE;
+                    }
+                    piece = const_cast<unsigned char *>(data + offset);  // Bulk OUT transfers only read from the given buffer
+                    lengths[slot] = static_cast<int>(pieceSize);
+                }
+                if (pipelined) {
+                    completions[slot].done = false;
+                    submitBulkTransferGeneric(endpointOutAddr, WRITE, piece, lengths[slot], signalCompletion, &completions[slot], errcnt, errstr);  // Pieces other than the first carry no command header, but still belong to the Write command
+                    ++nPending;
+                } else {
+                    int bytesWritten = 0;
+                    bulkTransferGeneric(endpointOutAddr, WRITE, piece, lengths[slot], &bytesWritten, errcnt, errstr);
+                }
+                ++nextPiece;
+            }
+            if (nPending == 0) {
+                break;
+            }
+            TransferResult result = waitCompletion(completions[head]);  // Transfers still in flight are waited for even in case of error, since their buffers must remain valid until they complete
+            if (preverrcnt == errcnt && (transferError(result) != 0 || result.transferred != lengths[head])) {
+                bulkTransferFailed(endpointOutAddr, transferError(result), errcnt, errstr);
+            }
+            head = (head + 1) % depth;
+            --nPending;
+        }
+    }
 }
 
 // This function is a shorthand version of the previous one (the endpoint OUT address is automatically deduced at the cost of decreased speed)
-void CP2130::spiWrite(const std::vector<uint8_t> &data, int &errcnt, std::string &errstr)
+void CP2130::spiWriteStream(const uint8_t *data, size_t bytesToWrite, size_t depth, int &errcnt, std::string &errstr)
 {
-    spiWrite(data, getEndpointOutAddr(errcnt, errstr), errcnt, errstr);
+    spiWriteStream(data, bytesToWrite, depth, getEndpointOutAddr(errcnt, errstr), errcnt, errstr);
 }
 
 // Writes to the SPI bus while reading back, returning a vector of the same size as the one given
 // This is the prefered method of writing and reading, if both endpoint addresses are known
+// The data is split into chunks whose commands are pipelined, so that the command of the next chunk is already in flight while the response to the current one is read
 std::vector<uint8_t> CP2130::spiWriteRead(const std::vector<uint8_t> &data, uint8_t endpointInAddr, uint8_t endpointOutAddr, int &errcnt, std::string &errstr)
 {
     size_t bytesToWriteRead = data.size();
-    size_t bytesProcessed = 0;  // Loop control variable implemented in version 1.2.3, to replace "bytesLeft"
-    std::vector<uint8_t> retdata;
+    size_t nChunks = (bytesToWriteRead + SPI_CHUNK_SIZE - 1) / SPI_CHUNK_SIZE;
+    size_t bytesRead = 0;
+    std::vector<uint8_t> retdata(bytesToWriteRead);  // Responses are read directly into the vector
+    std::lock_guard<std::mutex> lock(spiMutex_);
     int preverrcnt = errcnt;
-    while (bytesProcessed < bytesToWriteRead && preverrcnt == errcnt) {  // The extra condition breaks the loop in case of error (added in version 1.2.4)
-        size_t bytesRemaining = bytesToWriteRead - bytesProcessed;  // Equivalent to the variable "bytesLeft" found in version 1.2.2, except that it is no longer used for control
-        uint32_t payload = static_cast<uint32_t>(bytesRemaining > 56 ? 56 : bytesRemaining);
-        int bufSize = payload + 8;
-        unsigned char *writeReadCommandBuffer = new unsigned char[bufSize] {
-            0x00, 0x00,         // Reserved
-            CP2130::WRITEREAD,  // WriteRead command
-            0x00,               // Reserved
-            static_cast<uint8_t>(payload),
-            static_cast<uint8_t>(payload >> 8),
-            static_cast<uint8_t>(payload >> 16),
-            static_cast<uint8_t>(payload >> 24)
-        };
-        for (size_t i = 0; i < payload; ++i) {
-            writeReadCommandBuffer[i + 8] = data[bytesProcessed + i];
+    if (onCompletionThread()) {  // If called from a completion callback, the chunks cannot be pipelined, since that would require waiting for the event handling thread
+        for (size_t n = 0; n < nChunks && preverrcnt == errcnt; ++n) {  // The extra condition breaks the loop in case of error
+            uint32_t payload = fillSPIChunk(spiBuffer_.data(), data, n);
+            int bytesWritten = 0, bytesReadChunk = 0;
+            bulkTransfer(endpointOutAddr, spiBuffer_.data(), static_cast<int>(SPI_HEADER_SIZE + payload), &bytesWritten, errcnt, errstr);
+            bulkTransfer(endpointInAddr, retdata.data() + n * SPI_CHUNK_SIZE, static_cast<int>(payload), &bytesReadChunk, errcnt, errstr);
+            if (preverrcnt == errcnt) {
+                bytesRead += static_cast<size_t>(bytesReadChunk);
+            }
         }
-#if LIBUSB_API_VERSION >= 0x01000105
-        bulkTransfer(endpointOutAddr, writeReadCommandBuffer, bufSize, nullptr, errcnt, errstr);
-#else
-        int bytesWritten;
-        bulkTransfer(endpointOutAddr, writeReadCommandBuffer, bufSize, &bytesWritten, errcnt, errstr);
-#endif
-        delete[] writeReadCommandBuffer;
-        unsigned char *writeReadInputBuffer = new unsigned char[payload];
-        int bytesRead = 0;  // Important!
-        bulkTransfer(endpointInAddr, writeReadInputBuffer, payload, &bytesRead, errcnt, errstr);
-        size_t prevretdataSize = retdata.size();
-        retdata.resize(static_cast<size_t>(prevretdataSize + bytesRead));  // Optimization implemented in version 1.2.2, and fixed in version 1.2.3
-        for (int i = 0; i < bytesRead; ++i) {
-            retdata[prevretdataSize + i] = writeReadInputBuffer[i];  // Note that std::vector::push_back() is no longer used since version 1.2.2, because it is more efficient to resize the vector only once per iteration (see above), so that the values may be simply assigned (fixed in version 1.2.3)
+    } else if (nChunks > 0) {
+        Completion outCompletions[2], inCompletion;  // One completion per slot of the transfer buffer, since the commands of two consecutive chunks can be in flight at the same time
+        uint32_t payloads[2];
+        payloads[0] = fillSPIChunk(spiBuffer_.data(), data, 0);
+        outCompletions[0].done = false;
+        submitBulkTransfer(endpointOutAddr, spiBuffer_.data(), static_cast<int>(SPI_HEADER_SIZE + payloads[0]), signalCompletion, &outCompletions[0], errcnt, errstr);
+        for (size_t n = 0; n < nChunks; ++n) {
+            size_t slot = n % 2, nextSlot = (n + 1) % 2;
+            inCompletion.done = false;
+            submitBulkTransfer(endpointInAddr, retdata.data() + n * SPI_CHUNK_SIZE, static_cast<int>(payloads[slot]), signalCompletion, &inCompletion, errcnt, errstr);
+            bool nextPending = n + 1 < nChunks && preverrcnt == errcnt;
+            if (nextPending) {  // The slot of the next chunk is free, since the command that used it was waited for in the previous iteration
+                unsigned char *nextBuffer = spiBuffer_.data() + nextSlot * SPI_BUFFER_SIZE;
+                payloads[nextSlot] = fillSPIChunk(nextBuffer, data, n + 1);
+                outCompletions[nextSlot].done = false;
+                submitBulkTransfer(endpointOutAddr, nextBuffer, static_cast<int>(SPI_HEADER_SIZE + payloads[nextSlot]), signalCompletion, &outCompletions[nextSlot], errcnt, errstr);
+            }
+            TransferResult outResult = waitCompletion(outCompletions[slot]);
+            TransferResult inResult = waitCompletion(inCompletion);
+            if (transferError(outResult) != 0 || outResult.transferred != static_cast<int>(SPI_HEADER_SIZE + payloads[slot])) {
+                bulkTransferFailed(endpointOutAddr, transferError(outResult), errcnt, errstr);
+            } else if (transferError(inResult) != 0 || inResult.transferred != static_cast<int>(payloads[slot])) {
+                bulkTransferFailed(endpointInAddr, transferError(inResult), errcnt, errstr);
+            } else {
+                bytesRead += static_cast<size_t>(inResult.transferred);
+            }
+            if (preverrcnt != errcnt) {  // In case of error, the command of the next chunk is waited for, since its buffer must remain valid until it completes
+                if (nextPending) {
+                    waitCompletion(outCompletions[nextSlot]);
+                }
+                break;
+            }
         }
-        delete[] writeReadInputBuffer;
-        bytesProcessed += payload;  // Note that, since version 1.2.3, the loop control variable is added to (it is generaly a bad idea to subtract from a unsigned variable, because it can lead to a overflow that may go unchecked)
     }
+    retdata.resize(bytesRead);  // Only the data read before any error is returned
     return retdata;
 }
 
@@ -975,14 +1770,80 @@ std::vector<uint8_t> CP2130::spiWriteRead(const std::vector<uint8_t> &data, int
 }
 
 // Aborts the current ReadWithRTR command
+// This also makes any ongoing spiReadWithRTR() call return, by cancelling its queued transfers (transfers done through a custom transport cannot be cancelled, so they are waited for instead)
 void CP2130::stopRTR(int &errcnt, std::string &errstr)
 {
+    stopRTR_ = true;
+    {
+        std::lock_guard<std::mutex> lock(transferMutex_);
+        for (Transfer *transfer : rtrTransfers_) {
+            libusb_cancel_transfer(transfer->transfer);  // Each transfer still completes, from the event handling thread, with LIBUSB_TRANSFER_CANCELLED as status
+        }
+    }
     unsigned char controlBufferOut[SET_RTR_STOP_WLEN] = {
         0x01  // Abort current ReadWithRTR command
     };
     controlTransfer(SET, SET_RTR_STOP, 0x0000, 0x0000, controlBufferOut, SET_RTR_STOP_WLEN, errcnt, errstr);
 }
 
+// Submits a bulk transfer and returns immediately, without waiting for it to complete (added in version 1.3.0)
+// The callback is invoked exactly once, from the event handling thread (or from the completion thread of a custom transport), or from the calling thread if the transfer could not be submitted
+// The given buffer is used directly, and must remain valid until the callback is invoked
+void CP2130::submitBulkTransfer(uint8_t endpointAddr, unsigned char *data, int length, TransferCallback callback, void *userData, int &errcnt, std::string &errstr)
+{
+    submitBulkTransferGeneric(endpointAddr, bulkRequest(endpointAddr, data, length), data, length, callback, userData, errcnt, errstr);
+}
+
+// Submits a control transfer and returns immediately, without waiting for it to complete (added in version 1.3.0)
+// The callback is invoked exactly once, from the event handling thread (or from the completion thread of a custom transport), or from the calling thread if the transfer could not be submitted
+// For Host-to-Device requests, the data is copied before this function returns, while for Device-to-Host requests, it is copied to the given buffer just before the callback is invoked
+void CP2130::submitControlTransfer(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength, TransferCallback callback, void *userData, int &errcnt, std::string &errstr)
+{
+    Transfer *transfer;
+    if (!isOpen()) {
+        ++errcnt;
+        errstr += "In submitControlTransfer(): device is not open.\n";  // Program logic error
+        callback({LIBUSB_ERROR_NO_DEVICE, 0}, userData);
+    } else if ((transfer = acquireTransfer()) == nullptr) {
+        callback({LIBUSB_ERROR_NO_MEM, 0}, userData);
+    } else {
+        transfer->observed = observer_ != nullptr;
+        if (transfer->observed) {
+            transfer->record = {TRANSFER_CONTROL, bRequest, wLength, false, observer_->timestamp(), 0};
+        }
+        transfer->buffer.resize(LIBUSB_CONTROL_SETUP_SIZE + wLength);
+        libusb_fill_control_setup(transfer->buffer.data(), bmRequestType, bRequest, wValue, wIndex, wLength);
+        if (bmRequestType < 0x80) {  // Host-to-Device request
+            if (wLength > 0) {
+                std::memcpy(transfer->buffer.data() + LIBUSB_CONTROL_SETUP_SIZE, data, wLength);
+            }
+            transfer->data = nullptr;
+        } else {  // Device-to-Host request
+            transfer->data = data;
+        }
+        transfer->callback = callback;
+        transfer->userData = userData;
+        transfer->rtr = false;
+        if (transport_ != nullptr) {  // The transport gets the data stage, which remains valid until the transfer completes
+            transport_->submitControlTransfer(bmRequestType, bRequest, wValue, wIndex, transfer->buffer.data() + LIBUSB_CONTROL_SETUP_SIZE, wLength, completeTransportTransfer, transfer);
+        } else {
+            libusb_fill_control_transfer(transfer->transfer, handle_, transfer->buffer.data(), completeTransfer, transfer, TR_TIMEOUT);
+            submitTransfer(transfer);
+        }
+    }
+}
+
+// Submits a write to the GPIO pins, according to the given values and mask bitmaps, and returns immediately, without waiting for it to complete (added in version 1.3.0)
+// The callback semantics are the same as those of submitControlTransfer(), so that several writes can be queued while keying
+void CP2130::submitGPIOs(uint16_t bmValues, uint16_t bmMask, TransferCallback callback, void *userData, int &errcnt, std::string &errstr)
+{
+    unsigned char controlBufferOut[SET_GPIO_VALUES_WLEN] = {
+        static_cast<uint8_t>((BMGPIOS & bmValues) >> 8), static_cast<uint8_t>(BMGPIOS & bmValues),  // GPIO values bitmap
+        static_cast<uint8_t>((BMGPIOS & bmMask) >> 8), static_cast<uint8_t>(BMGPIOS & bmMask)       // Mask bitmap
+    };
+    submitControlTransfer(SET, SET_GPIO_VALUES, 0x0000, 0x0000, controlBufferOut, SET_GPIO_VALUES_WLEN, callback, userData, errcnt, errstr);  // The buffer is copied before this returns
+}
+
 // This procedure is used to lock fields in the CP2130 OTP ROM - Use with care!
 void CP2130::writeLockWord(uint16_t word, int &errcnt, std::string &errstr)
 {
@@ -1025,6 +1886,7 @@ void CP2130::writePinConfig(const PinConfig &config, int &errcnt, std::string &e
         config.divider                                                                               // Clock divider
     };
     controlTransfer(SET, SET_PIN_CONFIG, PROM_WRITE_KEY, 0x0000, controlBufferOut, SET_PIN_CONFIG_WLEN, errcnt, errstr);
+    invalidateProfile();  // Same as above
 }
 
 // Writes the product descriptor to the CP2130 OTP ROM
@@ -1048,6 +1910,7 @@ void CP2130::writePROMConfig(const PROMConfig &config, int &errcnt, std::string
         }
         controlTransfer(SET, SET_PROM_CONFIG, PROM_WRITE_KEY, static_cast<uint16_t>(i), controlBufferOut, SET_PROM_CONFIG_WLEN, errcnt, errstr);
     }
+    invalidateProfile();  // Writing to the OTP ROM invalidates the device profile
 }
 
 // Writes the serial descriptor to the CP2130 OTP ROM
@@ -1074,6 +1937,7 @@ void CP2130::writeUSBConfig(const USBConfig &config, uint8_t mask, int &errcnt,
         mask                                                                      // Write mask (can be obtained using the return value of getLockWord(), after being bitwise ANDed with "LWUSBCFG" [0x009f] and the resulting value cast to uint8_t)
     };
     controlTransfer(SET, SET_USB_CONFIG, PROM_WRITE_KEY, 0x0000, controlBufferOut, SET_USB_CONFIG_WLEN, errcnt, errstr);
+    invalidateProfile();  // Same as above
 }
 
 // Helper function to list devices
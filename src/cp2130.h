@@ -1,5 +1,5 @@
-/* CP2130 class - Version 1.2.5
-   Copyright (c) 2021-2022 Samuel Lourenço
+/* CP2130 class - Version 1.3.0
+   Copyright (c) 2021-2026 Samuel Lourenço
 
    This library is free software: you can redistribute it and/or modify it
    under the terms of the GNU Lesser General Public License as published by
@@ -22,22 +22,109 @@
 #define CP2130_H
 
 // Includes
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <future>
 #include <list>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
+#include <pthread.h>
 #include <libusb-1.0/libusb.h>
 
 class CP2130
 {
+public:
+    struct TransferResult {
+        int status;       // Transfer status (see libusb_transfer_status), or a negative libusb error code if the transfer could not be submitted
+        int transferred;  // Number of bytes actually transferred (excluding the setup packet, in the case of control transfers)
+    };
+
+    typedef void (*TransferCallback)(const TransferResult &result, void *userData);  // Called from the event handling thread (or from the completion thread of a custom transport) when an asynchronous transfer completes
+    typedef void (*SPIDataCallback)(const uint8_t *data, size_t length, void *userData);  // Called from the calling thread of spiReadWithRTR() whenever data is received, and must not call any SPI function other than stopRTR()
+
+    // Interface to be implemented by transports other than libusb, such as simulated devices (added in version 1.3.0)
+    // Both synchronous functions have the same semantics as their libusb counterparts, returning the number of bytes transferred (control transfers) or zero (bulk transfers) if successful, or a negative libusb error code otherwise
+    // The asynchronous functions invoke the callback exactly once, in order of submission, and the given buffer must remain valid until then (by default, they perform the synchronous transfer and invoke the callback before returning)
+    class Transport
+    {
+    public:
+        virtual ~Transport();
+
+        virtual bool isCompletionThread() const;
+
+        virtual int bulkTransfer(uint8_t endpointAddr, unsigned char *data, int length, int *transferred) = 0;
+        virtual int controlTransfer(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength) = 0;
+        virtual void submitBulkTransfer(uint8_t endpointAddr, unsigned char *data, int length, TransferCallback callback, void *userData);
+        virtual void submitControlTransfer(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength, TransferCallback callback, void *userData);
+    };
+
+    // Transfer types applicable to TransferRecord (added in version 1.3.0)
+    static const uint8_t TRANSFER_CONTROL = 0;   // Control transfer
+    static const uint8_t TRANSFER_BULK_OUT = 1;  // Bulk OUT transfer
+    static const uint8_t TRANSFER_BULK_IN = 2;   // Bulk IN transfer
+
+    struct TransferRecord {
+        uint8_t type;     // Transfer type (TRANSFER_CONTROL, TRANSFER_BULK_OUT or TRANSFER_BULK_IN)
+        uint8_t request;  // Request code of a control transfer, or SPI command carried by a bulk OUT transfer (zero for bulk IN transfers)
+        int length;       // Number of bytes to be transferred (excluding the setup packet, in the case of control transfers)
+        bool success;     // True if the transfer completed successfully
+        int64_t start;    // Timestamp taken before the transfer is issued (in ns, as returned by TransferObserver::timestamp())
+        int64_t end;      // Timestamp taken after the transfer completes
+    };
+
+    // Interface to be implemented by objects that observe every transfer, such as latency statistics (added in version 1.3.0)
+    // Note that transferCompleted() may be called from the event handling thread, concurrently with the calling thread, so it must be thread-safe and should return quickly
+    class TransferObserver
+    {
+    public:
+        virtual ~TransferObserver();
+
+        virtual int64_t timestamp() const = 0;
+        virtual void transferCompleted(const TransferRecord &record) = 0;
+    };
+
 private:
+    struct Profile;   // Device profile, defined in cp2130.cpp
+    struct Transfer;  // Pooled transfer, defined in cp2130.cpp
+
     libusb_context *context_;
     libusb_device_handle *handle_;
-    bool disconnected_, kernelWasAttached_;
-
+    Transport *transport_;
+    TransferObserver *observer_;
+    bool kernelWasAttached_;
+    std::atomic<bool> disconnected_, stopEvents_, stopRTR_;
+    std::atomic<uint8_t> rtrEndpointAddr_;  // Endpoint IN address used by the ongoing spiReadWithRTR() call, or zero if none
+    std::thread eventThread_;
+    std::mutex transferMutex_;
+    std::condition_variable transferCondition_;
+    std::vector<Transfer *> freeTransfers_;  // Protected by "transferMutex_"
+    size_t pendingTransfers_;                // Protected by "transferMutex_"
+    std::vector<Transfer *> rtrTransfers_;   // IN transfers of spiReadWithRTR() in flight, which stopRTR() cancels, protected by "transferMutex_"
+    bool profileEnabled_, profileValid_;
+    Profile *profile_;                       // Allocated by the constructor, and only used if valid
+    std::mutex spiMutex_;
+    std::vector<unsigned char> spiBuffer_;   // Reusable buffer holding command headers, along with the payload that fits in the same packet, protected by "spiMutex_"
+
+    Transfer *acquireTransfer();
+    void bulkTransferFailed(uint8_t endpointAddr, int result, int &errcnt, std::string &errstr);
+    void bulkTransferGeneric(uint8_t endpointAddr, uint8_t command, unsigned char *data, int length, int *transferred, int &errcnt, std::string &errstr);
+    void controlTransferFailed(uint8_t bmRequestType, uint8_t bRequest, int result, int &errcnt, std::string &errstr);
+    uint32_t fillSPIChunk(unsigned char *slot, const std::vector<uint8_t> &data, size_t chunk);
     std::u16string getDescGeneric(uint8_t command, int &errcnt, std::string &errstr);
+    void handleEvents();
+    bool onCompletionThread() const;
+    void observeTransfer(uint8_t type, uint8_t request, int length, bool success, int64_t start);
+    void releaseTransfer(Transfer *transfer);
+    void submitBulkTransferGeneric(uint8_t endpointAddr, uint8_t command, unsigned char *data, int length, TransferCallback callback, void *userData, int &errcnt, std::string &errstr);
+    void submitTransfer(Transfer *transfer);
     void writeDescGeneric(const std::u16string &descriptor, uint8_t command, int &errcnt, std::string &errstr);
 
+    static void LIBUSB_CALL completeTransfer(libusb_transfer *transfer);
+    static void completeTransportTransfer(const TransferResult &result, void *userData);
+
 public:
     // Class definitions
     static const uint16_t VID = 0x10c4;    // Default USB vendor ID
@@ -87,10 +174,18 @@ public:
     static const size_t PROMSZE_LOCK_BYTE = 2;                      // 'Lock Byte' field size
 
     // The following values are applicable to bulkTransfer()
-    static const uint8_t READ = 0x00;         // Read command
-    static const uint8_t WRITE = 0x01;        // Write command
-    static const uint8_t WRITEREAD = 0x02;    // WriteRead command
-    static const uint8_t READWITHRTR = 0x04;  // ReadWithRTR command
+    static const uint8_t READ = 0x00;                  // Read command
+    static const uint8_t WRITE = 0x01;                 // Write command
+    static const uint8_t WRITEREAD = 0x02;             // WriteRead command
+    static const uint8_t READWITHRTR = 0x04;           // ReadWithRTR command
+    static const size_t SPI_HEADER_SIZE = 8;           // Size of the command header that precedes every SPI transfer
+    static const size_t SPI_CHUNK_SIZE = 56;           // Maximum payload of each WriteRead command, so that every response fits in a single short packet
+    static const size_t RTR_QUEUE_DEPTH = 4;           // Number of IN transfers kept queued by spiReadWithRTR()
+    static const size_t RTR_TRANSFER_SIZE = 512;       // Size of each IN transfer queued by spiReadWithRTR(), which is a multiple of the maximum packet size
+    static const size_t SPI_BUFFER_SIZE = 64;          // Size of each of the two slots of the SPI transfer buffer, holding a header followed by a chunk of payload
+    static const size_t SPI_STREAM_DEPTH_DEFAULT = 4;  // Number of bulk transfers kept in flight when spiWrite() streams data that does not fit in a single packet
+    static const size_t SPI_STREAM_DEPTH_MAX = 8;      // Maximum number of bulk transfers kept in flight by spiWriteStream()
+    static const size_t SPI_STREAM_PIECE_SIZE = 1024;  // Size of the pieces into which spiWriteStream() splits data, which is a multiple of the maximum packet size
 
     // The following values are applicable to controlTransfer()
     static const uint8_t GET = 0xc0;                                 // Device-to-Host vendor request
@@ -329,18 +424,26 @@ public:
     CP2130();
     ~CP2130();
 
+    CP2130(const CP2130 &) = delete;             // Copying is not allowed, since the object owns the event handling thread
+    CP2130 &operator =(const CP2130 &) = delete;
+
     bool disconnected() const;
     bool isOpen() const;
+    bool isProfileEnabled() const;
+    bool isProfileValid() const;
 
     void bulkTransfer(uint8_t endpointAddr, unsigned char *data, int length, int *transferred, int &errcnt, std::string &errstr);
+    std::future<TransferResult> bulkTransferAsync(uint8_t endpointAddr, unsigned char *data, int length, int &errcnt, std::string &errstr);
     void close();
     void configureGPIO(uint8_t pin, uint8_t mode, bool value, int &errcnt, std::string &errstr);
     void configureSPIDelays(uint8_t channel, const SPIDelays &delays, int &errcnt, std::string &errstr);
     void configureSPIMode(uint8_t channel, const SPIMode &mode, int &errcnt, std::string &errstr);
     void controlTransfer(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength, int &errcnt, std::string &errstr);
+    std::future<TransferResult> controlTransferAsync(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength, int &errcnt, std::string &errstr);
     void disableCS(uint8_t channel, int &errcnt, std::string &errstr);
     void disableSPIDelays(uint8_t channel, int &errcnt, std::string &errstr);
     void enableCS(uint8_t channel, int &errcnt, std::string &errstr);
+    bool eventThreadHandle(pthread_t &handle);
     uint8_t getClockDivider(int &errcnt, std::string &errstr);
     bool getCS(uint8_t channel, int &errcnt, std::string &errstr);
     uint8_t getEndpointInAddr(int &errcnt, std::string &errstr);
@@ -370,11 +473,14 @@ public:
     SPIMode getSPIMode(uint8_t channel, int &errcnt, std::string &errstr);
     uint8_t getTransferPriority(int &errcnt, std::string &errstr);
     USBConfig getUSBConfig(int &errcnt, std::string &errstr);
+    void invalidateProfile();
     bool isOTPBlank(int &errcnt, std::string &errstr);
     bool isOTPLocked(int &errcnt, std::string &errstr);
     bool isRTRActive(int &errcnt, std::string &errstr);
     void lockOTP(int &errcnt, std::string &errstr);
     int open(uint16_t vid, uint16_t pid, const std::string &serial = std::string());
+    int open(Transport &transport);
+    void refreshProfile(int &errcnt, std::string &errstr);
     void reset(int &errcnt, std::string &errstr);
     void selectCS(uint8_t channel, int &errcnt, std::string &errstr);
     void setClockDivider(uint8_t value, int &errcnt, std::string &errstr);
@@ -392,13 +498,24 @@ public:
     void setGPIO9(bool value, int &errcnt, std::string &errstr);
     void setGPIO10(bool value, int &errcnt, std::string &errstr);
     void setGPIOs(uint16_t bmValues, uint16_t bmMask, int &errcnt, std::string &errstr);
+    void setProfileEnabled(bool value);
+    void setTransferObserver(TransferObserver *observer);
     std::vector<uint8_t> spiRead(uint32_t bytesToRead, uint8_t endpointInAddr, uint8_t endpointOutAddr, int &errcnt, std::string &errstr);
     std::vector<uint8_t> spiRead(uint32_t bytesToRead, int &errcnt, std::string &errstr);
+    size_t spiRead(uint8_t *data, uint32_t bytesToRead, uint8_t endpointInAddr, uint8_t endpointOutAddr, int &errcnt, std::string &errstr);
+    size_t spiReadWithRTR(uint32_t bytesToRead, SPIDataCallback callback, void *userData, uint8_t endpointInAddr, uint8_t endpointOutAddr, int &errcnt, std::string &errstr);
+    size_t spiReadWithRTR(uint32_t bytesToRead, SPIDataCallback callback, void *userData, int &errcnt, std::string &errstr);
     void spiWrite(const std::vector<uint8_t> &data, uint8_t endpointOutAddr, int &errcnt, std::string &errstr);
     void spiWrite(const std::vector<uint8_t> &data, int &errcnt, std::string &errstr);
+    void spiWrite(const uint8_t *data, size_t bytesToWrite, uint8_t endpointOutAddr, int &errcnt, std::string &errstr);
+    void spiWriteStream(const uint8_t *data, size_t bytesToWrite, size_t depth, uint8_t endpointOutAddr, int &errcnt, std::string &errstr);
+    void spiWriteStream(const uint8_t *data, size_t bytesToWrite, size_t depth, int &errcnt, std::string &errstr);
     std::vector<uint8_t> spiWriteRead(const std::vector<uint8_t> &data, uint8_t endpointInAddr, uint8_t endpointOutAddr, int &errcnt, std::string &errstr);
     std::vector<uint8_t> spiWriteRead(const std::vector<uint8_t> &data, int &errcnt, std::string &errstr);
     void stopRTR(int &errcnt, std::string &errstr);
+    void submitBulkTransfer(uint8_t endpointAddr, unsigned char *data, int length, TransferCallback callback, void *userData, int &errcnt, std::string &errstr);
+    void submitControlTransfer(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength, TransferCallback callback, void *userData, int &errcnt, std::string &errstr);
+    void submitGPIOs(uint16_t bmValues, uint16_t bmMask, TransferCallback callback, void *userData, int &errcnt, std::string &errstr);
     void writeLockWord(uint16_t word, int &errcnt, std::string &errstr);
     void writeManufacturerDesc(const std::u16string &manufacturer, int &errcnt, std::string &errstr);
     void writePinConfig(const PinConfig &config, int &errcnt, std::string &errstr);
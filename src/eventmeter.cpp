@@ -0,0 +1,115 @@
+/* EventMeter class - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+
+// Includes
+#include "eventmeter.h"
+
+// Prints the summary of the measurements (values are displayed in microseconds, and frequencies in hertz)
+void EventMeter::Summary::print(std::ostream &stream) const
+{
+    stream << "Event counter measurement:\n"
+           << "  Elements: " << elements << "\n"
+           << "  Overflows: " << overflows << "\n"
+           << "  Tone frequency: " << frequency << "Hz (nominal " << nominal << "Hz)\n"
+           << "  Mean on-time error: " << errorMean / 1000 << "us\n"
+           << "  Maximum on-time error: " << errorMax / 1000 << "us\n"
+           << "  Final compensation: " << compensation / 1000 << "us\n";
+}
+
+// The nominal frequency is the one to which the waveform generator was set, in hertz
+EventMeter::EventMeter(GF2Device &device, double frequency) :
+    device_(device),
+    frequency_(frequency),
+    elements_(0),
+    overflows_(0),
+    counts_(0),
+    compensation_(0),
+    errorSum_(0),
+    errorMax_(0),
+    hostTime_(0)
+{
+}
+
+// Returns the correction to be applied to the deadline of the end of each element (negative values end elements earlier)
+int64_t EventMeter::compensation() const
+{
+    return compensation_;
+}
+
+// Returns a summary of the measurements taken since the meter was started
+EventMeter::Summary EventMeter::summary() const
+{
+    Summary summary;
+    summary.elements = elements_;
+    summary.overflows = overflows_;
+    summary.nominal = frequency_;
+    summary.frequency = hostTime_ == 0 ? 0 : 1000000000.0 * static_cast<double>(counts_) / static_cast<double>(hostTime_);
+    summary.errorMean = elements_ == 0 ? 0 : errorSum_ / static_cast<int64_t>(elements_);
+    summary.errorMax = errorMax_;
+    summary.compensation = compensation_;
+    return summary;
+}
+
+// Measures the element that just ended, given its ideal on-time and the on-time seen by the host, which is the time between the completion of both DAC transfers (in ns)
+// This must be called while the DAC is disabled, so that no cycles are lost between reading and clearing the counter
+void EventMeter::measure(int64_t idealOnTime, int64_t hostOnTime, int &errcnt, std::string &errstr)
+{
+    int preverrcnt = errcnt;
+    CP2130::EventCounter evtcntr = device_.getEventCounter(errcnt, errstr);
+    device_.setEventCounter({false, CP2130::PCEVTCNTRRE, 0}, errcnt, errstr);  // The counter is cleared after each element, so that an overflow only affects the element during which it occurred
+    if (errcnt == preverrcnt) {
+        if (evtcntr.overflow) {
+            ++overflows_;
+        } else {
+            int64_t onTime = static_cast<int64_t>(1000000000.0 * evtcntr.value / frequency_ + 0.5);
+            int64_t error = onTime - idealOnTime;
+            ++elements_;
+            counts_ += evtcntr.value;
+            hostTime_ += hostOnTime;
+            errorSum_ += error;
+            if ((error < 0 ? -error : error) > errorMax_) {
+                errorMax_ = error < 0 ? -error : error;
+            }
+            compensation_ -= static_cast<int64_t>(COMPENSATION_GAIN * static_cast<double>(error));
+            compensation_ = compensation_ > COMPENSATION_MAX ? COMPENSATION_MAX : (compensation_ < -COMPENSATION_MAX ? -COMPENSATION_MAX : compensation_);
+        }
+    }
+}
+
+// Configures GPIO.4 as an event counter input, counting rising edges, and clears both the counter and the measurements
+// The DAC must be disabled at this point
+void EventMeter::start(int &errcnt, std::string &errstr)
+{
+    device_.setEventCounter({false, CP2130::PCEVTCNTRRE, 0}, errcnt, errstr);
+    elements_ = 0;
+    overflows_ = 0;
+    counts_ = 0;
+    compensation_ = 0;
+    errorSum_ = 0;
+    errorMax_ = 0;
+    hostTime_ = 0;
+}
+
+// Returns the longest on-time that can be measured at the given frequency (in hertz) without overflowing the 16-bit counter (in ns)
+int64_t EventMeter::maxOnTime(double frequency)
+{
+    return static_cast<int64_t>(1000000000.0 * 0xffff / frequency);
+}
@@ -0,0 +1,73 @@
+/* EventMeter class - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+
+#ifndef EVENTMETER_H
+#define EVENTMETER_H
+
+// Includes
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include "gf2device.h"
+
+// Measures the length of each keyed element on the device itself, using the event counter of the CP2130 bridge
+// This requires the synchronous clock output to be wired to GPIO.4/EVTCNTR (which then no longer drives the FSEL signal), so that the counter advances once per cycle while the DAC is enabled
+// Reading the counter after each element yields the number of cycles that were actually output, from which the on-time is derived, and the difference to the ideal on-time is fed back as a correction to the end of subsequent elements
+class EventMeter
+{
+public:
+    struct Summary {
+        size_t elements;       // Number of elements measured
+        size_t overflows;      // Number of elements whose count overflowed, which are not taken into account
+        double nominal;        // Nominal tone frequency (in Hz)
+        double frequency;      // Tone frequency, estimated from the total count and the total on-time as seen by the host (in Hz)
+        int64_t errorMean;     // Mean on-time error, which is the measured on-time minus the ideal on-time (in ns)
+        int64_t errorMax;      // Maximum absolute on-time error (in ns)
+        int64_t compensation;  // Correction applied to the end of each element after the last measurement (in ns)
+
+        void print(std::ostream &stream) const;
+    };
+
+private:
+    GF2Device &device_;
+    double frequency_;   // Nominal tone frequency (in Hz)
+    size_t elements_, overflows_;
+    uint64_t counts_;    // Sum of the counts of all measured elements
+    int64_t compensation_, errorSum_, errorMax_, hostTime_;
+
+public:
+    // Values applicable to the compensation
+    static constexpr double COMPENSATION_GAIN = 0.25;  // Fraction of each on-time error that is corrected, so that the quantization of the count is averaged out
+    static const int64_t COMPENSATION_MAX = 10000000;  // Maximum correction, in either direction (in ns)
+
+    EventMeter(GF2Device &device, double frequency);
+
+    int64_t compensation() const;
+    Summary summary() const;
+
+    void measure(int64_t idealOnTime, int64_t hostOnTime, int &errcnt, std::string &errstr);
+    void start(int &errcnt, std::string &errstr);
+
+    static int64_t maxOnTime(double frequency);
+};
+
+#endif  // EVENTMETER_H
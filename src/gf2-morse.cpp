@@ -1,5 +1,5 @@
-/* GF2 Morse Command - Version 2.0 for Debian Linux
-   Copyright (c) 2020-2024 Samuel Lourenço
+/* GF2 Morse Command - Version 2.1 for Debian Linux
+   Copyright (c) 2020-2026 Samuel Lourenço
 
    This program is free software: you can redistribute it and/or modify it
    under the terms of the GNU General Public License as published by the Free
@@ -19,47 +19,360 @@
 
 
 // Includes
+#include <atomic>
+#include <cerrno>
 #include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
 #include <iostream>
-#include <map>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
+#include <time.h>
 #include <unistd.h>
+#include "clock.h"
 #include "error.h"
+#include "eventmeter.h"
 #include "gf2device.h"
+#include "gf2simulator.h"
+#include "hopping.h"
+#include "keyer.h"
+#include "mfsk.h"
+#include "morsecode.h"
+#include "morsed.h"
+#include "psk31.h"
+#include "realtime.h"
+#include "rtty.h"
+#include "transferstats.h"
 
 // Global variables
-int EXIT_USERERR = 2;  // Exit status value to indicate a command usage error
-int TUNIT = 50000;     // Time unit in us
+int EXIT_USERERR = 2;         // Exit status value to indicate a command usage error
+int REALTIME_PRIORITY = 50;   // SCHED_FIFO priority of the keying thread, applicable to real-time mode
+int SPIN_MARGIN = 200;        // Default spin margin in us, applicable to real-time mode
+int TUNIT = 50000;            // Time unit in us (24 WPM), unless changed via --wpm
+const char *USAGE = "Usage: gf2-morse [--socket PATH] [--timing-report] [--timing-trace] [--wpm N] [--high-speed] [--measure KHZ] MESSAGE|- [SERIALNUMBER]\n"
+                    "       gf2-morse [--timing-report] [--timing-trace] [--wpm N] [--high-speed] [--measure KHZ] [--interval S] --repeat N MESSAGE [SERIALNUMBER]\n"
+                    "       gf2-morse [--timing-report] [--timing-trace] [--high-speed] --psk31 MESSAGE [SERIALNUMBER]\n"
+                    "       gf2-morse [--timing-report] [--timing-trace] [--shift HZ] --rtty KHZ MESSAGE [SERIALNUMBER]\n"
+                    "       gf2-morse [--timing-report] [--timing-trace] --ft8|--wspr KHZ FILE [SERIALNUMBER]\n"
+                    "       gf2-morse [--timing-report] [--timing-trace] [--dwell MS] --hop FILE [SERIALNUMBER]\n"
+                    "       gf2-morse --calibrate --measure KHZ [SERIALNUMBER]\n"
+                    "Any of the above, except --calibrate, also accepts --simulate US[,JITTER[,uniform|normal|exponential]] [--virtual-clock] in place of SERIALNUMBER,\n"
+                    "as well as [--realtime] [--cpu N] [--spin-margin US] [--compensate] for real-time keying, [--stats] [--stats-json PATH],\n"
+                    "and [--timeline-csv PATH] [--timeline-vcd PATH].\n";
+
+struct KeyingOptions {
+    bool timingReport;          // True if a timing report is to be displayed
+    bool timingTrace;           // True if a timing trace is to be displayed
+    RealTimeSettings realTime;  // Real-time settings applicable to the keying thread
+    int64_t spinMargin;         // Margin before each deadline during which the keyer spins (in ns)
+    std::string timelineCSV;    // Path of the file to which the timeline is to be written in CSV format, or empty if none
+    std::string timelineVCD;    // Path of the file to which the timeline is to be written in VCD format, or empty if none
+    uint64_t tunit;             // Morse code time unit (in ns), used to calculate the effective speed, or zero if not applicable
+    float measure;              // Frequency (in KHz) at which elements are keyed and measured through the event counter, or zero if elements are not measured
+    bool compensate;            // True if DAC transfers are to be issued early, in order to compensate for their latency
+    bool highSpeed;             // True if DAC transfers are to be pipelined, after measuring the speed limit of the device
+};
 
 // Function prototypes
-void signalCharCode(GF2Device &device, const std::string &code, int &errcnt, std::string &errstr);
-void signalMessage(GF2Device &device, const std::string &message, int &errcnt, std::string &errstr);
+bool parseLatencyModel(const std::string &model, GF2Simulator::LatencyModel &latency);
+void printTiming(const Keyer &keyer, const KeyingOptions &options, int &errcnt, std::string &errstr);
+void readStream(KeyEventRing &events, std::atomic<bool> &finished, const std::atomic<bool> &aborted);
+void setupKeyer(Keyer &keyer, const KeyingOptions &options, int &errcnt, std::string &errstr);
+void setupMeter(GF2Device &device, Keyer &keyer, EventMeter &meter, const KeyingOptions &options, int &errcnt, std::string &errstr);
+void signalHops(GF2Device &device, const std::string &path, uint64_t dwell, const KeyingOptions &options, int &errcnt, std::string &errstr);
+void signalMessage(GF2Device &device, const std::string &message, unsigned int repeat, uint64_t interval, const KeyingOptions &options, int &errcnt, std::string &errstr);
+void signalMFSK(GF2Device &device, const MFSKMode &mode, double frequency, const std::string &path, const KeyingOptions &options, int &errcnt, std::string &errstr);
+void signalPSK31(GF2Device &device, const std::string &message, const KeyingOptions &options, int &errcnt, std::string &errstr);
+void signalRTTY(GF2Device &device, const std::string &message, float mark, float space, const KeyingOptions &options, int &errcnt, std::string &errstr);
+void signalStream(GF2Device &device, const KeyingOptions &options, int &errcnt, std::string &errstr);
 
 int main(int argc, char **argv)
 {
-    int err, errlvl = EXIT_SUCCESS;
-    if (argc < 2) {  // If the program was called without arguments
-        std::cerr << "Error: Missing argument.\nUsage: gf2-morse MESSAGE\n";
+    int err, fd, errlvl = EXIT_SUCCESS;
+    bool calibrate = false, psk31 = false, realTime = false, simulate = false, stats = false, virtualClock = false;
+    bool localDevice = false;  // True if the message has to be signaled by this process, instead of being submitted to gf2-morsed
+    KeyingOptions keying = {false, false, {0, -1, false}, 0, "", "", 0, 0, false, false};
+    long spinMargin = -1;  // Spin margin in us, or -1 if not specified
+    unsigned long repeat = 1;  // Number of times the message is signaled
+    unsigned long wpm = 0;  // Speed in WPM, or zero if not specified
+    double interval = 0;  // Interval between the start of each repetition in seconds
+    double dwell = 10;  // Dwell time in ms, applicable to frequency hopping
+    float mark = 0, shift = RTTY_SHIFT;  // Mark frequency in KHz and shift in Hz, applicable to RTTY
+    const MFSKMode *mfsk = nullptr;
+    double base = 0;  // Frequency of the lowest tone in KHz, applicable to MFSK modes
+    GF2Simulator::LatencyModel latency = {0, 0, GF2Simulator::UNIFORM};  // Latency model applicable to the simulated device
+    std::string hopFile, socketPath = MORSED_SOCKET, statsPath;
+    std::vector<std::string> args;  // Non-option arguments
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--", 2) == 0 && std::strcmp(argv[i], "--socket") != 0) {  // Any option other than --socket requests something that gf2-morsed does not provide
+            localDevice = true;
+        }
+        if (std::strcmp(argv[i], "--calibrate") == 0) {
+            calibrate = true;
+        } else if (std::strcmp(argv[i], "--compensate") == 0) {
+            keying.compensate = true;
+        } else if (std::strcmp(argv[i], "--cpu") == 0 && i + 1 < argc) {
+            char *end;
+            long cpu = std::strtol(argv[++i], &end, 10);
+            if (*end != '\0' || cpu < 0 || cpu >= CPU_SETSIZE) {
+                std::cerr << "Error: CPU must be a non-negative integer.\n";
+                errlvl = EXIT_USERERR;
+            }
+            keying.realTime.cpu = static_cast<int>(cpu);
+        } else if (std::strcmp(argv[i], "--dwell") == 0 && i + 1 < argc) {
+            char *end;
+            dwell = std::strtod(argv[++i], &end);
+            if (*end != '\0' || !(dwell > 0)) {
+                std::cerr << "Error: Dwell time must be a positive number of milliseconds.\n";
+                errlvl = EXIT_USERERR;
+            }
+        } else if ((std::strcmp(argv[i], "--ft8") == 0 || std::strcmp(argv[i], "--wspr") == 0) && i + 1 < argc) {
+            mfsk = std::strcmp(argv[i], "--ft8") == 0 ? &MFSK_FT8 : &MFSK_WSPR;
+            char *end;
+            base = std::strtod(argv[++i], &end);
+            if (*end != '\0' || !(base > GF2Device::FREQUENCY_MIN) || base > GF2Device::FREQUENCY_MAX) {
+                std::cerr << "Error: Base frequency must be greater than " << GF2Device::FREQUENCY_MIN << "KHz and no greater than " << GF2Device::FREQUENCY_MAX << "KHz.\n";
+                errlvl = EXIT_USERERR;
+            }
+        } else if (std::strcmp(argv[i], "--high-speed") == 0) {
+            keying.highSpeed = true;
+        } else if (std::strcmp(argv[i], "--hop") == 0 && i + 1 < argc) {
+            hopFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+            char *end;
+            interval = std::strtod(argv[++i], &end);
+            if (*end != '\0' || !(interval >= 0) || interval > 86400) {
+                std::cerr << "Error: Interval must be a number of seconds between 0 and 86400.\n";
+                errlvl = EXIT_USERERR;
+            }
+        } else if (std::strcmp(argv[i], "--measure") == 0 && i + 1 < argc) {
+            char *end;
+            keying.measure = std::strtof(argv[++i], &end);
+            if (*end != '\0' || !(keying.measure > GF2Device::FREQUENCY_MIN) || keying.measure > GF2Device::FREQUENCY_MAX) {
+                std::cerr << "Error: Measurement frequency must be greater than " << GF2Device::FREQUENCY_MIN << "KHz and no greater than " << GF2Device::FREQUENCY_MAX << "KHz.\n";
+                errlvl = EXIT_USERERR;
+            }
+        } else if (std::strcmp(argv[i], "--psk31") == 0) {
+            psk31 = true;
+        } else if (std::strcmp(argv[i], "--realtime") == 0) {
+            realTime = true;
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            char *end;
+            repeat = std::strtoul(argv[++i], &end, 10);
+            if (*end != '\0' || argv[i][0] == '-' || repeat < 1 || repeat > 100000) {
+                std::cerr << "Error: Number of repetitions must be between 1 and 100000.\n";
+                errlvl = EXIT_USERERR;
+            }
+        } else if (std::strcmp(argv[i], "--rtty") == 0 && i + 1 < argc) {
+            char *end;
+            mark = std::strtof(argv[++i], &end);
+            if (*end != '\0' || !(mark > GF2Device::FREQUENCY_MIN) || mark > GF2Device::FREQUENCY_MAX) {
+                std::cerr << "Error: Mark frequency must be greater than " << GF2Device::FREQUENCY_MIN << "KHz and no greater than " << GF2Device::FREQUENCY_MAX << "KHz.\n";
+                errlvl = EXIT_USERERR;
+            }
+        } else if (std::strcmp(argv[i], "--shift") == 0 && i + 1 < argc) {
+            char *end;
+            shift = std::strtof(argv[++i], &end);
+            if (*end != '\0' || !(shift > 0)) {
+                std::cerr << "Error: Shift must be a positive number of hertz.\n";
+                errlvl = EXIT_USERERR;
+            }
+        } else if (std::strcmp(argv[i], "--simulate") == 0 && i + 1 < argc) {
+            simulate = true;
+            if (!parseLatencyModel(argv[++i], latency)) {
+                std::cerr << "Error: Latency model must be in the form US[,JITTER[,uniform|normal|exponential]].\n";
+                errlvl = EXIT_USERERR;
+            }
+        } else if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--spin-margin") == 0 && i + 1 < argc) {
+            char *end;
+            spinMargin = std::strtol(argv[++i], &end, 10);
+            if (*end != '\0' || spinMargin < 0 || spinMargin > 100000) {
+                std::cerr << "Error: Spin margin must be between 0 and 100000us.\n";
+                errlvl = EXIT_USERERR;
+            }
+        } else if (std::strcmp(argv[i], "--stats") == 0) {
+            stats = true;
+        } else if (std::strcmp(argv[i], "--stats-json") == 0 && i + 1 < argc) {
+            statsPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--timeline-csv") == 0 && i + 1 < argc) {
+            keying.timelineCSV = argv[++i];
+        } else if (std::strcmp(argv[i], "--timeline-vcd") == 0 && i + 1 < argc) {
+            keying.timelineVCD = argv[++i];
+        } else if (std::strcmp(argv[i], "--timing-report") == 0) {
+            keying.timingReport = true;
+        } else if (std::strcmp(argv[i], "--timing-trace") == 0) {
+            keying.timingTrace = true;
+        } else if (std::strcmp(argv[i], "--virtual-clock") == 0) {
+            virtualClock = true;
+        } else if (std::strcmp(argv[i], "--wpm") == 0 && i + 1 < argc) {
+            char *end;
+            wpm = std::strtoul(argv[++i], &end, 10);
+            if (*end != '\0' || argv[i][0] == '-' || wpm < 5 || wpm > 300) {
+                std::cerr << "Error: Speed must be between 5 and 300 WPM.\n";
+                errlvl = EXIT_USERERR;
+            }
+        } else if (std::strncmp(argv[i], "--", 2) == 0) {  // Unknown option, or missing option argument
+            std::cerr << "Error: Invalid option " << argv[i] << ".\n";
+            errlvl = EXIT_USERERR;
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    if (realTime) {  // Real-time mode applies SCHED_FIFO and locks memory, besides spinning before each deadline
+        keying.realTime.priority = REALTIME_PRIORITY;
+        keying.realTime.lockMemory = true;
+    }
+    if (wpm >= 5 && wpm <= 300) {
+        TUNIT = static_cast<int>(1200000 / wpm);  // A dot lasts 1.2s divided by the speed in WPM (PARIS standard)
+    }
+    keying.spinMargin = 1000 * static_cast<int64_t>(spinMargin >= 0 ? spinMargin : (realTime ? SPIN_MARGIN : 0));
+    keying.tunit = psk31 || mark > 0 || mfsk != nullptr || !hopFile.empty() ? 0 : 1000 * static_cast<uint64_t>(TUNIT);  // The effective speed only applies to Morse code
+    size_t serialIndex = calibrate || !hopFile.empty() ? 0 : 1;  // Calibration and frequency hopping take no message, so the serial number is the first argument in those cases
+    bool rtty = mark > 0, streaming = serialIndex == 1 && !args.empty() && args[0] == "-";
+    if (args.size() > serialIndex || streaming) {  // A specific device, as well as streaming, is also only available locally
+        localDevice = true;
+    }
+    if (errlvl == EXIT_SUCCESS && rtty && mark - shift / 1000 < GF2Device::FREQUENCY_MIN) {
+        std::cerr << "Error: Shift must not exceed the mark frequency.\n";
+        errlvl = EXIT_USERERR;
+    }
+    float measureMax = static_cast<float>(EventMeter::maxOnTime(1000) / (3000.0 * TUNIT));  // The longest element (a dash) must not overflow the event counter, which depends on the speed
+    if (errlvl == EXIT_SUCCESS && calibrate && keying.measure > GF2Device::CALIBRATION_FREQUENCY_MAX) {
+        std::cerr << "Error: Measurement frequency must not exceed " << GF2Device::CALIBRATION_FREQUENCY_MAX << "KHz during calibration.\n";
+        errlvl = EXIT_USERERR;
+    } else if (errlvl == EXIT_SUCCESS && !calibrate && keying.measure > measureMax) {
+        std::cerr << "Error: Measurement frequency must not exceed " << measureMax << "KHz at " << 1200000 / TUNIT << " WPM.\n";
+        errlvl = EXIT_USERERR;
+    }
+    bool otherMode = psk31 || rtty || mfsk != nullptr;  // True if a mode other than Morse code was requested
+    if (errlvl != EXIT_SUCCESS) {  // If an invalid option was passed
+        std::cerr << USAGE;
+    } else if (args.size() > serialIndex + 1) {  // If too many arguments were passed
+        std::cerr << "Error: Too many arguments.\n" << USAGE;
+        errlvl = EXIT_USERERR;
+    } else if (psk31 + rtty + (mfsk != nullptr) > 1) {
+        std::cerr << "Error: Only one of --psk31, --rtty, --ft8 or --wspr can be specified.\n";
+        errlvl = EXIT_USERERR;
+    } else if (otherMode && serialIndex == 0) {
+        std::cerr << "Error: --psk31, --rtty, --ft8 and --wspr cannot be combined with --calibrate or --hop.\n";
+        errlvl = EXIT_USERERR;
+    } else if (calibrate && !hopFile.empty()) {
+        std::cerr << "Error: --calibrate cannot be combined with --hop.\n";
+        errlvl = EXIT_USERERR;
+    } else if (calibrate && keying.measure == 0) {  // Calibration needs a frequency to count
+        std::cerr << "Error: --calibrate requires --measure.\n";
+        errlvl = EXIT_USERERR;
+    } else if (simulate && calibrate) {  // The simulated device has no settle time to calibrate
+        std::cerr << "Error: --calibrate is not applicable to a simulated device.\n";
+        errlvl = EXIT_USERERR;
+    } else if (simulate && args.size() > serialIndex) {
+        std::cerr << "Error: A serial number is not applicable to a simulated device.\n";
+        errlvl = EXIT_USERERR;
+    } else if (virtualClock && !simulate) {
+        std::cerr << "Error: --virtual-clock is only applicable to a simulated device.\n";
+        errlvl = EXIT_USERERR;
+    } else if (virtualClock && streaming) {  // Virtual time would not wait for the input
+        std::cerr << "Error: --virtual-clock is not applicable while streaming.\n";
         errlvl = EXIT_USERERR;
+    } else if ((repeat > 1 || interval > 0) && (serialIndex == 0 || otherMode || streaming)) {
+        std::cerr << "Error: --repeat and --interval are only applicable to Morse code messages, and not while streaming.\n";
+        errlvl = EXIT_USERERR;
+    } else if (keying.measure > 0 && ((serialIndex == 0 && !calibrate) || otherMode)) {  // Other modes need GPIO.4 to drive the FSEL signal
+        std::cerr << "Error: --measure is only applicable to Morse code messages, and to --calibrate.\n";
+        errlvl = EXIT_USERERR;
+    } else if (wpm != 0 && (serialIndex == 0 || otherMode)) {
+        std::cerr << "Error: --wpm is only applicable to Morse code messages.\n";
+        errlvl = EXIT_USERERR;
+    } else if (keying.highSpeed && (serialIndex == 0 || rtty || mfsk != nullptr)) {  // PSK31 reversals are as frequent as Morse code elements, unlike RTTY and MFSK tone changes, which involve staged frequency writes
+        std::cerr << "Error: --high-speed is only applicable to Morse code and PSK31 messages.\n";
+        errlvl = EXIT_USERERR;
+    } else if (keying.highSpeed && keying.measure > 0) {  // Reading the event counter at the end of each element would hold up the transfers in flight
+        std::cerr << "Error: --high-speed cannot be combined with --measure.\n";
+        errlvl = EXIT_USERERR;
+    } else if (args.size() < serialIndex) {  // If the program was called without a message
+        std::cerr << "Error: Missing argument.\n" << USAGE;
+        errlvl = EXIT_USERERR;
+    } else if (!localDevice && (fd = connectDaemon(socketPath)) >= 0) {  // If gf2-morsed is running, the message is submitted to it (unless a specific or simulated device, another mode or any other option that gf2-morsed does not provide is requested)
+        std::string reply;
+        std::cout << "Submitting message to gf2-morsed...\n";
+        if (!submitMessage(fd, args[0], reply)) {
+            std::cerr << "Error: Lost connection to gf2-morsed.\n";
+            errlvl = EXIT_FAILURE;
+        } else if (reply.compare(0, 3, "OK ") == 0) {  // The reply contains the queue wait and transmit times, in microseconds
+            std::istringstream stream(reply.substr(3));
+            long long wait = 0, transmit = 0;
+            stream >> wait >> transmit;
+            std::cout << "Message signaled (queue wait: " << wait << "us, transmit: " << transmit << "us).\n";
+        } else {
+            printErrors(reply.compare(0, 6, "ERROR ") == 0 ? reply.substr(6) : "Unexpected reply from gf2-morsed.\n");
+            errlvl = EXIT_FAILURE;
+        }
     } else {
+        VirtualClock clock;  // The clock and the simulator are declared before the device, so that they outlive it
+        GF2Simulator simulator;
+        TransferStatistics statistics(simulate && virtualClock ? static_cast<const Clock &>(clock) : Clock::system());  // Transfers are measured in virtual time if a virtual clock is used
         GF2Device device;
-        if (argc < 3) {  // If no serial number was specified
+        if (stats || !statsPath.empty()) {
+            device.setTransferObserver(&statistics);
+        }
+        if (simulate) {
+            simulator.setBulkLatency(latency);
+            simulator.setControlLatency(latency);
+            if (virtualClock) {  // Transfers, settle times and the keyer all take virtual time, so that the message is signaled as fast as possible
+                simulator.setClock(&clock);
+                device.setClock(clock);
+            }
+            err = device.open(simulator);  // Open the simulated device
+        } else if (args.size() <= serialIndex) {  // If no serial number was specified
             err = device.open();  // Open a device and get the device handle
-        } else {  // Serial number was specified as a second (optional) argument
-            err = device.open(argv[2]);  // Open the device having the specified serial number, and get the device handle
+        } else {  // Serial number was specified as the last (optional) argument
+            err = device.open(args[serialIndex]);  // Open the device having the specified serial number, and get the device handle
         }
         if (err == GF2Device::SUCCESS) {  // Device was successfully opened
             int errcnt = 0;
             std::string errstr;
-            if (!device.isWaveGenEnabled(errcnt, errstr) && errcnt == 0) {  // Check if the waveform generator is enabled (errcnt can increment as a consequence of that verification, hence the need for " && errcnt == 0" in order to avoid misleading messages)
+            device.setGPIOCacheEnabled(true);  // The GPIO pins are read only once, and redundant writes are skipped
+            if (calibrate) {
+                std::cout << "Calibrating chip select settle time...\n";
+                unsigned int settleTime = device.calibrateSettleTime(keying.measure, errcnt, errstr);
+                if (errcnt == 0) {  // Operation successful
+                    std::cout << "Settle time calibrated to " << settleTime << "us.\nDevice cleared.\n";
+                }
+            } else if (!device.isWaveGenEnabled(errcnt, errstr) && errcnt == 0) {  // Check if the waveform generator is enabled (errcnt can increment as a consequence of that verification, hence the need for " && errcnt == 0" in order to avoid misleading messages)
                 std::cerr << "Error: Waveform generator is stopped and should be running.\nPlease invoke gf2-start and try again.\n";
             } else if (device.isDACEnabled(errcnt, errstr) && errcnt == 0) {  // Check if the DAC internal to the AD9834 waveform generator is enabled (again, the same precaution is needed)
                 std::cerr << "Error: Waveform generator DAC is enabled and should be disabled.\nPlease invoke gf2-dacoff and try again.\n";
             } else if (errcnt == 0) {  // If all goes well so far
-                std::cout << "Signaling message...\n";
-                signalMessage(device, argv[1], errcnt, errstr);
-                if (errcnt == 0) {  // Operation successful
-                    std::cout << "Message signaled.\n";
+                if (!hopFile.empty()) {  // Frequency hopping
+                    std::cout << "Hopping frequencies...\n";
+                    signalHops(device, hopFile, static_cast<uint64_t>(dwell * 1000000 + 0.5), keying, errcnt, errstr);
+                    if (errcnt == 0) {  // Operation successful
+                        std::cout << "Frequency hopping done.\n";
+                    }
+                } else if (mfsk != nullptr) {
+                    signalMFSK(device, *mfsk, base, args[0], keying, errcnt, errstr);
+                    if (errcnt == 0) {  // Operation successful
+                        std::cout << "Transmission done.\n";
+                    }
+                } else {
+                    std::cout << "Signaling message...\n";
+                    if (psk31) {
+                        signalPSK31(device, args[0], keying, errcnt, errstr);
+                    } else if (rtty) {
+                        signalRTTY(device, args[0], mark, mark - shift / 1000, keying, errcnt, errstr);
+                    } else if (args[0] == "-") {  // Message is read from the standard input
+                        signalStream(device, keying, errcnt, errstr);
+                    } else {
+                        signalMessage(device, args[0], static_cast<unsigned int>(repeat), static_cast<uint64_t>(interval * 1000000000 + 0.5), keying, errcnt, errstr);
+                    }
+                    if (errcnt == 0) {  // Operation successful
+                        std::cout << "Message signaled.\n";
+                    }
                 }
             }
             if (errcnt > 0) {  // In case of error
@@ -71,6 +384,25 @@ int main(int argc, char **argv)
                 errlvl = EXIT_FAILURE;
             }
             device.close();
+            if (simulate) {
+                GF2Simulator::Statistics statistics = simulator.statistics();
+                std::cout << "Simulation: " << statistics.controlTransfers << " control transfers, " << statistics.bulkTransfers << " bulk transfers, " << statistics.spiBytes << " SPI bytes, " << statistics.busyTime / 1000 << "us of simulated latency";
+                if (virtualClock) {
+                    std::cout << ", " << clock.monotonicTime() / 1000 << "us of virtual time";
+                }
+                std::cout << ".\n";
+            }
+            if (stats) {
+                statistics.print(std::cout);
+            }
+            if (!statsPath.empty()) {
+                std::ofstream file(statsPath);
+                statistics.writeJSON(file);
+                if (!file) {
+                    std::cerr << "Error: Could not write statistics to " << statsPath << ".\n";
+                    errlvl = EXIT_FAILURE;
+                }
+            }
         } else {  // Failed to open device
             if (err == GF2Device::ERROR_INIT) {  // Failed to initialize libusb
                 std::cerr << "Error: Could not initialize libusb\n";
@@ -85,99 +417,291 @@ int main(int argc, char **argv)
     return errlvl;
 }
 
-void signalCharCode(GF2Device &device, const std::string &code, int &errcnt, std::string &errstr)  // Signals character code (adding a trailing inter-character space)
+bool parseLatencyModel(const std::string &model, GF2Simulator::LatencyModel &latency)  // Parses a latency model in the form US[,JITTER[,DISTRIBUTION]], returning false if it is malformed
+{
+    std::istringstream stream(model);
+    std::string field;
+    std::vector<std::string> fields;
+    while (std::getline(stream, field, ',')) {
+        fields.push_back(field);
+    }
+    if (fields.empty() || fields.size() > 3) {
+        return false;
+    }
+    unsigned long values[2] = {0, 0};
+    for (size_t i = 0; i < fields.size() && i < 2; ++i) {
+        char *end;
+        values[i] = std::strtoul(fields[i].c_str(), &end, 10);
+        if (fields[i].empty() || fields[i][0] == '-' || *end != '\0' || values[i] > 1000000) {  // Latencies up to one second are accepted
+            return false;
+        }
+    }
+    latency.base = static_cast<unsigned int>(values[0]);
+    latency.jitter = static_cast<unsigned int>(values[1]);
+    latency.distribution = GF2Simulator::UNIFORM;
+    if (fields.size() == 3) {
+        if (fields[2] == "normal") {
+            latency.distribution = GF2Simulator::NORMAL;
+        } else if (fields[2] == "exponential") {
+            latency.distribution = GF2Simulator::EXPONENTIAL;
+        } else if (fields[2] != "uniform") {
+            return false;
+        }
+    }
+    return true;
+}
+
+void printTiming(const Keyer &keyer, const KeyingOptions &options, int &errcnt, std::string &errstr)  // Prints the timing trace and/or the timing report, and writes the timeline, if requested, as well as warnings about real-time settings that could not be applied
+{
+    const Keyer::TimingReport &report = keyer.report();
+    if (options.realTime.priority > 0 && !report.fifo) {
+        std::cerr << "Warning: Could not apply SCHED_FIFO scheduling (insufficient privileges?), so normal scheduling was used.\n";
+    }
+    if (options.realTime.lockMemory && !report.locked) {
+        std::cerr << "Warning: Could not lock memory (insufficient privileges?), so page faults may have delayed some transitions.\n";
+    }
+    if (options.realTime.cpu >= 0 && !report.pinned) {
+        std::cerr << "Warning: Could not pin the keying thread to CPU " << options.realTime.cpu << ".\n";
+    }
+    if (options.compensate) {  // The leads in use are displayed even without a timing report, since they reflect the latencies measured
+        std::cout << "Latency compensation: DAC enable lead " << report.enableLead / 1000 << "us, DAC disable lead " << report.disableLead / 1000 << "us, FSEL lead " << report.fselLead / 1000 << "us, PSEL lead " << report.pselLead / 1000 << "us.\n";
+    }
+    if (options.timingTrace) {
+        keyer.printTrace(std::cout);
+    }
+    if (options.timingReport) {
+        report.print(std::cout);
+    }
+    if (!options.timelineCSV.empty() || !options.timelineVCD.empty()) {  // The timeline is only written once keying ends, so that writing it does not disturb the timing
+        const Timeline &timeline = keyer.timeline();
+        if (!options.timelineCSV.empty()) {
+            std::ofstream file(options.timelineCSV);
+            timeline.writeCSV(file);
+            if (!file) {
+                ++errcnt;
+                errstr += "Could not write timeline to " + options.timelineCSV + ".\n";
+            }
+        }
+        if (!options.timelineVCD.empty()) {
+            std::ofstream file(options.timelineVCD);
+            timeline.writeVCD(file);
+            if (!file) {
+                ++errcnt;
+                errstr += "Could not write timeline to " + options.timelineVCD + ".\n";
+            }
+        }
+        timeline.printSummary(std::cout, options.tunit);
+    }
+}
+
+void readStream(KeyEventRing &events, std::atomic<bool> &finished, const std::atomic<bool> &aborted)  // Reads the standard input until EOF, encoding each character as soon as it arrives
+{
+    std::vector<KeyEvent> encoded;
+    encoded.reserve(32);  // Enough for any single character, so that no allocations take place after the first one
+    uint64_t time = 0;
+    char buffer[256], previous = '\0';
+    ssize_t bytesRead;
+    while (!aborted.load() && (bytesRead = read(STDIN_FILENO, buffer, sizeof(buffer))) != 0) {
+        if (bytesRead < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;  // Treat read errors as EOF
+        }
+        for (ssize_t i = 0; i < bytesRead && !aborted.load(); ++i) {
+            encoded.clear();
+            compileCharacter(buffer[i], previous, 1000 * static_cast<uint64_t>(TUNIT), time, encoded);
+            previous = buffer[i];
+            size_t encodedSize = encoded.size();
+            for (size_t j = 0; j < encodedSize && !aborted.load(); ) {
+                if (events.push(encoded[j])) {
+                    ++j;
+                } else {  // The ring buffer is full, so the reader waits for the keyer to catch up
+                    timespec ts = {0, 1000000};
+                    nanosleep(&ts, nullptr);
+                }
+            }
+        }
+    }
+    KeyEvent end = {time, false, '\0'};  // End of message
+    while (!aborted.load() && !events.push(end)) {
+        timespec ts = {0, 1000000};
+        nanosleep(&ts, nullptr);
+    }
+    finished.store(true, std::memory_order_release);
+}
+
+void setupKeyer(Keyer &keyer, const KeyingOptions &options, int &errcnt, std::string &errstr)  // Applies the given options to the keyer, measuring the latency of DAC transfers if latency compensation was requested, and the speed limit of the device if high-speed mode was requested
 {
-    size_t strLength = code.size();
-    for (size_t i = 0; i < strLength; ++i) {
-        if (code[i] == '.' || code [i] == '-') {  // This condition is only required for sanity purposes
-            device.setDACEnabled(true, errcnt, errstr);  // Enable the AD9834 internal DAC
-            usleep(TUNIT);  // Corresponds to a "dot"
-            if (code[i] == '-') {
-                usleep(2 * TUNIT);  // Adds to the previous time interval so it corresponds to a "dash"
+    keyer.setLatencyCompensation(options.compensate);
+    if (options.compensate) {
+        keyer.calibrateLatency(errcnt, errstr);
+    }
+    keyer.setPipelined(options.highSpeed);
+    if (options.highSpeed && errcnt == 0) {  // The speed limit is measured before keying, so that the user is warned if the requested speed exceeds it
+        Keyer::SpeedLimit limit = keyer.measureSpeedLimit(errcnt, errstr);
+        if (errcnt == 0) {
+            limit.print(std::cout);
+            if (limit.wpm > 0 && options.tunit == 0 && 1200000000.0 / PSK31_SYMBOL > limit.wpm) {  // High-speed mode is only applicable to Morse code and PSK31, and a PSK31 symbol must be at least as long as the shortest sustainable dot
+                std::cerr << "Warning: PSK31 symbol rate exceeds the maximum sustainable speed of this device.\n";
+            } else if (limit.wpm > 0 && options.tunit > 0 && 1200000.0 / TUNIT > limit.wpm) {
+                std::cerr << "Warning: Speed of " << 1200000 / TUNIT << " WPM exceeds the maximum sustainable speed of this device.\n";
             }
-            device.setDACEnabled(false, errcnt, errstr);  // Disable the AD9834 internal DAC
-            usleep(TUNIT);  // Corresponds to an intra-character space
         }
     }
-    usleep(2 * TUNIT);  // Inter-character space
+    keyer.setRealTime(options.realTime);
+    keyer.setSpinMargin(options.spinMargin);
+    keyer.setTraceEnabled(options.timingTrace || !options.timelineCSV.empty() || !options.timelineVCD.empty());
 }
 
-void signalMessage(GF2Device &device, const std::string &message, int &errcnt, std::string &errstr)  // Signals message
+void setupMeter(GF2Device &device, Keyer &keyer, EventMeter &meter, const KeyingOptions &options, int &errcnt, std::string &errstr)  // Tunes the waveform generator to the measurement frequency and starts the given meter, if measurements were requested
 {
-    size_t strLength = message.size();
-    for (size_t i = 0; i < strLength; ++i) {
-        if ((message[i] == '\n' || message[i] == ' ') && i > 0 && message[i - 1] != '\n' && message[i - 1] != ' ') {  // Returns treated as spaces. Extra spaces and returns are to be omitted!
-            std::cout << " " << std::flush;
-            usleep(4 * TUNIT);  // Word space
+    if (options.measure > 0) {
+        device.setFrequency(GF2Device::FSEL0, options.measure, errcnt, errstr);  // FSELECT is assumed to be tied low, since GPIO.4 is wired to the synchronous clock output instead
+        meter.start(errcnt, errstr);
+        keyer.setMeter(&meter);
+    }
+}
+
+void signalHops(GF2Device &device, const std::string &path, uint64_t dwell, const KeyingOptions &options, int &errcnt, std::string &errstr)  // Hops through the frequencies whose codes are stored in the given file, each lasting for the given dwell time (in ns)
+{
+    std::vector<uint32_t> codes = loadFrequencyCodes(path, errcnt, errstr);
+    if (errcnt == 0) {
+        std::vector<KeyEvent> schedule = compileHops(codes, dwell);
+        Keyer keyer(device);
+        setupKeyer(keyer, options, errcnt, errstr);
+        if (errcnt == 0) {
+            keyer.run(schedule, errcnt, errstr);
+        }
+        if (errcnt == 0) {
+            printTiming(keyer, options, errcnt, errstr);
+        }
+    }
+}
+
+void signalMessage(GF2Device &device, const std::string &message, unsigned int repeat, uint64_t interval, const KeyingOptions &options, int &errcnt, std::string &errstr)  // Signals message the given number of times, each repetition starting "interval" nanoseconds after the previous one
+{
+    std::vector<KeyEvent> schedule = compileRepeatedMessage(message, 1000 * static_cast<uint64_t>(TUNIT), repeat, interval);  // The whole message is compiled beforehand, so that no processing takes place while keying
+    Keyer keyer(device);
+    EventMeter meter(device, 1000 * GF2Device::expectedFrequency(options.measure));
+    setupKeyer(keyer, options, errcnt, errstr);
+    setupMeter(device, keyer, meter, options, errcnt, errstr);
+    if (errcnt == 0) {
+        keyer.run(schedule, errcnt, errstr);
+        std::cout << "\n";
+    }
+    if (errcnt == 0) {
+        printTiming(keyer, options, errcnt, errstr);
+        if (options.measure > 0) {
+            meter.summary().print(std::cout);
+        }
+    }
+}
+
+void signalMFSK(GF2Device &device, const MFSKMode &mode, double frequency, const std::string &path, const KeyingOptions &options, int &errcnt, std::string &errstr)  // Transmits the symbols stored in the given file, in the given mode, starting at the next UTC-aligned slot
+{
+    std::vector<uint8_t> symbols = loadSymbols(mode, path, errcnt, errstr);
+    if (errcnt == 0) {
+        std::vector<std::vector<uint8_t>> frames = compileToneFrames(mode, frequency);  // Frames are built once, so that no frequency codes are calculated while transmitting
+        std::vector<KeyEvent> schedule = compileMFSK(mode, symbols, frames);
+        device.writeWaveGenFrame(frames[2 * symbols[0]], errcnt, errstr);  // The first tone is set and selected beforehand, so that the transmission starts with a single transfer
+        device.selectFrequency(GF2Device::FSEL0, errcnt, errstr);
+        if (errcnt == 0) {
+            Keyer keyer(device);
+            setupKeyer(keyer, options, errcnt, errstr);  // Any latency measurements take place before the slot is chosen, so that they cannot delay the first transition
+            if (errcnt == 0) {
+                int64_t start = nextSlot(mode, 100000000, device.clock());  // Slots starting in less than 100ms are skipped
+                time_t seconds = static_cast<time_t>(start / 1000000000);
+                char buffer[16];
+                std::strftime(buffer, sizeof(buffer), "%H:%M:%S", std::gmtime(&seconds));
+                std::cout << "Transmitting " << mode.name << " symbols at " << buffer << "." << (start % 1000000000) / 100000000 << " UTC...\n";
+                keyer.run(schedule, start, errcnt, errstr);
+            }
+            if (errcnt == 0) {
+                printTiming(keyer, options, errcnt, errstr);
+            }
+        }
+    }
+}
+
+void signalPSK31(GF2Device &device, const std::string &message, const KeyingOptions &options, int &errcnt, std::string &errstr)  // Signals message in PSK31
+{
+    GF2Device::Transaction transaction(device);
+    transaction.setPhase(GF2Device::PSEL0, 0);
+    transaction.setPhase(GF2Device::PSEL1, 180);  // Phase reversals are done by toggling PSEL between both registers
+    transaction.commit(errcnt, errstr);
+    if (errcnt == 0) {
+        std::vector<KeyEvent> schedule = compilePSK31Message(message);
+        Keyer keyer(device);
+        setupKeyer(keyer, options, errcnt, errstr);
+        if (errcnt == 0) {
+            keyer.run(schedule, errcnt, errstr);
+        }
+        std::cout << "\n";
+        if (errcnt == 0) {
+            printTiming(keyer, options, errcnt, errstr);
+        }
+    }
+}
+
+void signalRTTY(GF2Device &device, const std::string &message, float mark, float space, const KeyingOptions &options, int &errcnt, std::string &errstr)  // Signals message in RTTY, using the given mark and space frequencies (in KHz)
+{
+    GF2Device::Transaction transaction(device);
+    transaction.setFrequency(GF2Device::FSEL0, mark, errcnt, errstr);
+    transaction.setFrequency(GF2Device::FSEL1, space, errcnt, errstr);  // Keying is done by toggling FSEL between both registers
+    transaction.commit(errcnt, errstr);
+    if (errcnt == 0) {
+        std::vector<KeyEvent> schedule = compileRTTYMessage(message);
+        Keyer keyer(device);
+        setupKeyer(keyer, options, errcnt, errstr);
+        if (errcnt == 0) {
+            keyer.run(schedule, errcnt, errstr);
+        }
+        std::cout << "\n";
+        if (errcnt == 0) {
+            printTiming(keyer, options, errcnt, errstr);
+        }
+    }
+}
+
+void signalStream(GF2Device &device, const KeyingOptions &options, int &errcnt, std::string &errstr)  // Signals the message read from the standard input, while it is being read
+{
+    static KeyEventRing events;  // Shared state is static, so that it outlives a reader that has to be left behind
+    static EchoRing echo;
+    static std::atomic<bool> finished(false), aborted(false);
+    std::atomic<bool> done(false);
+    std::thread reader(readStream, std::ref(events), std::ref(finished), std::cref(aborted));
+    Keyer keyer(device);
+    EventMeter meter(device, 1000 * GF2Device::expectedFrequency(options.measure));
+    std::thread keying([&]() {
+        setupKeyer(keyer, options, errcnt, errstr);
+        setupMeter(device, keyer, meter, options, errcnt, errstr);
+        if (errcnt == 0) {
+            keyer.run(events, finished, echo, errcnt, errstr);
+        }
+        done.store(true, std::memory_order_release);
+    });
+    char character;
+    while (!done.load(std::memory_order_acquire) || !echo.empty()) {  // Characters are displayed from this thread, so that terminal output never delays the keyer
+        if (echo.pop(character)) {
+            std::cout << character << std::flush;
         } else {
-            char character = message[i];
-            if (character >= 'a' && character <= 'z') {  // If lowercase
-                character -= 32;  // Convert to uppercase
-            }
-            std::map<char, std::string> charCodes{
-                {'!', "-.-.--"},
-                {'"', ".-..-."},
-                {'$', "...-..-"},
-                {'&', ".-..."},
-                {'\'', ".----."},
-                {'(', "-.--."},
-                {')', "-.--.-"},
-                {'+', ".-.-."},
-                {',', "--..--"},
-                {'-', "-....-"},
-                {'.', ".-.-.-"},
-                {'/', "-..-."},
-                {'0', "-----"},
-                {'1', ".----"},
-                {'2', "..---"},
-                {'3', "...--"},
-                {'4', "....-"},
-                {'5', "....."},
-                {'6', "-...."},
-                {'7', "--..."},
-                {'8', "---.."},
-                {'9', "----."},
-                {':', "---..."},
-                {';', "-.-.-."},
-                {'=', "-...-"},
-                {'?', "..--.."},
-                {'@', ".--.-."},
-                {'A', ".-"},
-                {'B', "-..."},
-                {'C', "-.-."},
-                {'D', "-.."},
-                {'E', "."},
-                {'F', "..-."},
-                {'G', "--."},
-                {'H', "...."},
-                {'I', ".."},
-                {'J', ".---"},
-                {'K', "-.-"},
-                {'L', ".-.."},
-                {'M', "--"},
-                {'N', "-."},
-                {'O', "---"},
-                {'P', ".--."},
-                {'Q', "--.-"},
-                {'R', ".-."},
-                {'S', "..."},
-                {'T', "-"},
-                {'U', "..-"},
-                {'V', "...-"},
-                {'W', ".--"},
-                {'X', "-..-"},
-                {'Y', "-.--"},
-                {'Z', "--.."},
-                {'_', "..--.-"}
-            };
-            if (charCodes.count(character) > 0) {  // If character exists
-                std::cout << character << std::flush;  // Print character immediately!
-                signalCharCode(device, charCodes[character], errcnt, errstr);
-            }
-        }
-        if (errcnt != 0) {  // If one or more errors are detected
-            break;  // Break the cycle
+            timespec ts = {0, 1000000};
+            nanosleep(&ts, nullptr);
         }
     }
+    keying.join();
+    if (errcnt == 0) {
+        reader.join();
+    } else {  // The reader may be blocked waiting for input, so it is told to stop and left behind
+        aborted.store(true);
+        reader.detach();
+    }
     std::cout << "\n";
+    if (errcnt == 0) {
+        printTiming(keyer, options, errcnt, errstr);
+        if (options.measure > 0) {
+            meter.summary().print(std::cout);
+        }
+    }
 }
@@ -0,0 +1,297 @@
+/* GF2 Morse Daemon - Version 1.0.0 for Debian Linux
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "error.h"
+#include "gf2device.h"
+#include "keyer.h"
+#include "morsecode.h"
+#include "morsed.h"
+
+// Definitions
+const size_t MSG_MAXSIZE = 1048576;  // Maximum size of a message, in bytes
+const int RECEIVE_TIMEOUT = 5000;    // Time allowed for a client to send its whole message, in ms
+
+struct PendingClient {
+    int fd;                                          // Descriptor of the client socket
+    std::string message;                             // Part of the message received so far
+    std::chrono::steady_clock::time_point deadline;  // Instant by which the message must be received in full
+};
+
+struct QueuedMessage {
+    int fd;                                          // Descriptor of the client socket, to which the reply is sent
+    std::string message;                             // Message to be signaled
+    std::chrono::steady_clock::time_point enqueued;  // Instant when the message was queued
+};
+
+// Global variables
+int EXIT_USERERR = 2;            // Exit status value to indicate a command usage error
+int TUNIT = 50000;               // Time unit in us
+int listenfd = -1;               // Descriptor of the listening socket
+volatile sig_atomic_t quit = 0;  // Set to one when a termination signal is received
+
+std::mutex queueMutex;
+std::condition_variable queueCondition;
+std::deque<QueuedMessage> queue;
+bool stopping = false;  // Protected by "queueMutex"
+
+// Function prototypes
+void handleSignal(int signum);
+void receiveMessages(std::vector<PendingClient> &clients);
+void receiveMessages(std::vector<PendingClient> &clients)  // Accepts clients and receives their messages, all of them at once, queuing each message as soon as it is received in full, until the daemon is stopped
+{
+    std::vector<pollfd> fds;
+    while (quit == 0) {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        int timeout = -1;  // Wait for as long as it takes if no client is pending, or else until the earliest deadline
+        fds.assign(1, {listenfd, POLLIN, 0});
+        size_t clientsSize = clients.size();
+        for (size_t i = 0; i < clientsSize; ++i) {
+            fds.push_back({clients[i].fd, POLLIN, 0});
+            int remaining = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(clients[i].deadline - now).count()) + 1;  // Rounded up, so that poll() does not return before the deadline
+            if (timeout < 0 || remaining < timeout) {
+                timeout = remaining < 0 ? 0 : remaining;
+            }
+        }
+        if (poll(fds.data(), fds.size(), timeout) < 0) {
+            continue;  // Interrupted by a signal
+        }
+        now = std::chrono::steady_clock::now();
+        for (size_t i = clientsSize; i-- > 0;) {  // Traversed backwards, so that received and failed clients can be removed along the way
+            PendingClient &client = clients[i];
+            bool received = false, failed = false;
+            if (fds[i + 1].revents != 0) {  // A single read does not block, since the client socket is readable
+                char buffer[4096];
+                ssize_t nread = read(client.fd, buffer, sizeof(buffer));
+                if (nread == 0) {  // The client shut down its write side, marking the end of the message
+                    received = true;
+                } else if (nread < 0) {
+                    failed = errno != EINTR && errno != EAGAIN;
+                } else if (client.message.size() + static_cast<size_t>(nread) > MSG_MAXSIZE) {
+                    failed = true;
+                } else {
+                    client.message.append(buffer, static_cast<size_t>(nread));
+                }
+            } else if (now >= client.deadline) {  // A client that stalls while sending its message is dropped, without delaying the others
+                failed = true;
+            }
+            if (failed) {
+                writeAll(client.fd, "ERROR Failed to receive message.\n");
+                ::close(client.fd);
+            } else if (received) {
+                QueuedMessage entry = {client.fd, client.message, now};
+                std::lock_guard<std::mutex> lock(queueMutex);
+                if (stopping) {  // The worker stopped due to an error
+                    writeAll(client.fd, "ERROR Device is no longer available.\n");
+                    ::close(client.fd);
+                } else {
+                    queue.push_back(entry);
+                    queueCondition.notify_one();
+                }
+            }
+            if (failed || received) {
+                clients.erase(clients.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+        }
+        if (fds[0].revents != 0) {
+            int clientfd = accept(listenfd, nullptr, nullptr);
+            if (clientfd >= 0) {  // Otherwise, the client gave up, or the listening socket was shut down
+                clients.push_back({clientfd, std::string(), now + std::chrono::milliseconds(RECEIVE_TIMEOUT)});
+            }
+        }
+    }
+}
+
+void signalQueue(GF2Device &device, int &errcnt, std::string &errstr);
+
+int main(int argc, char **argv)
+{
+    int err, errlvl = EXIT_SUCCESS;
+    std::string socketPath = MORSED_SOCKET;
+    std::vector<std::string> args;  // Non-option arguments
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (std::strncmp(argv[i], "--", 2) == 0) {  // Unknown option, or missing option argument
+            std::cerr << "Error: Invalid option " << argv[i] << ".\n";
+            errlvl = EXIT_USERERR;
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    sockaddr_un addr;
+    if (errlvl != EXIT_SUCCESS || args.size() > 1) {  // If an invalid option or too many arguments were passed
+        std::cerr << "Usage: gf2-morsed [--socket PATH] [SERIALNUMBER]\n";
+        errlvl = EXIT_USERERR;
+    } else if (socketPath.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Error: Socket path is too long.\n";
+        errlvl = EXIT_USERERR;
+    } else {
+        int fd = connectDaemon(socketPath);
+        if (fd >= 0) {  // Another daemon is already accepting messages on the same socket
+            ::close(fd);
+            std::cerr << "Error: Another instance of gf2-morsed is already running.\n";
+            return EXIT_FAILURE;
+        }
+        GF2Device device;
+        if (args.empty()) {  // If no serial number was specified
+            err = device.open();  // Open a device and get the device handle
+        } else {  // Serial number was specified as an (optional) argument
+            err = device.open(args[0]);  // Open the device having the specified serial number, and get the device handle
+        }
+        if (err == GF2Device::SUCCESS) {  // Device was successfully opened, and will remain open until the daemon terminates
+            int errcnt = 0;
+            std::string errstr;
+            device.setGPIOCacheEnabled(true);  // The GPIO pins are read only once, and redundant writes are skipped
+            if (!device.isWaveGenEnabled(errcnt, errstr) && errcnt == 0) {  // Check if the waveform generator is enabled (errcnt can increment as a consequence of that verification, hence the need for " && errcnt == 0" in order to avoid misleading messages)
+                std::cerr << "Error: Waveform generator is stopped and should be running.\nPlease invoke gf2-start and try again.\n";
+                errlvl = EXIT_FAILURE;
+            } else if (device.isDACEnabled(errcnt, errstr) && errcnt == 0) {  // Check if the DAC internal to the AD9834 waveform generator is enabled (again, the same precaution is needed)
+                std::cerr << "Error: Waveform generator DAC is enabled and should be disabled.\nPlease invoke gf2-dacoff and try again.\n";
+                errlvl = EXIT_FAILURE;
+            } else if (errcnt == 0) {  // If all goes well so far
+                listenfd = socket(AF_UNIX, SOCK_STREAM, 0);
+                std::memset(&addr, 0, sizeof(addr));
+                addr.sun_family = AF_UNIX;
+                std::strcpy(addr.sun_path, socketPath.c_str());
+                unlink(socketPath.c_str());  // Remove any stale socket left behind by a previous instance
+                if (listenfd < 0 || bind(listenfd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || listen(listenfd, 16) != 0) {
+                    std::cerr << "Error: Could not create socket " << socketPath << ".\n";
+                    errlvl = EXIT_FAILURE;
+                } else {
+                    struct sigaction action;
+                    std::memset(&action, 0, sizeof(action));
+                    action.sa_handler = handleSignal;  // Note that SA_RESTART is not set, so that poll() is interrupted
+                    sigaction(SIGINT, &action, nullptr);
+                    sigaction(SIGTERM, &action, nullptr);
+                    std::signal(SIGPIPE, SIG_IGN);  // Clients that disconnect early should not terminate the daemon
+                    std::cout << "Accepting messages on " << socketPath << "..." << std::endl;
+                    std::thread worker(signalQueue, std::ref(device), std::ref(errcnt), std::ref(errstr));
+                    std::vector<PendingClient> clients;  // Clients whose messages are still being received
+                    receiveMessages(clients);
+                    for (size_t i = 0; i < clients.size(); ++i) {  // Messages that were still being received are dropped
+                        writeAll(clients[i].fd, "ERROR Daemon terminated before receiving message.\n");
+                        ::close(clients[i].fd);
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(queueMutex);
+                        stopping = true;
+                        queueCondition.notify_one();
+                    }
+                    worker.join();  // The message being signaled, if any, is allowed to finish
+                    for (size_t i = 0; i < queue.size(); ++i) {  // Messages that were still queued are dropped
+                        writeAll(queue[i].fd, "ERROR Daemon terminated before signaling message.\n");
+                        ::close(queue[i].fd);
+                    }
+                    unlink(socketPath.c_str());
+                }
+                if (listenfd >= 0) {
+                    ::close(listenfd);
+                }
+            }
+            if (errcnt > 0) {  // In case of error
+                if (device.disconnected()) {  // If the device disconnected
+                    std::cerr << "Error: Device disconnected.\n";
+                } else {
+                    printErrors(errstr);
+                }
+                errlvl = EXIT_FAILURE;
+            }
+            device.close();
+        } else {  // Failed to open device
+            if (err == GF2Device::ERROR_INIT) {  // Failed to initialize libusb
+                std::cerr << "Error: Could not initialize libusb\n";
+            } else if (err == GF2Device::ERROR_NOT_FOUND) {  // Failed to find device
+                std::cerr << "Error: Could not find device.\n";
+            } else if (err == GF2Device::ERROR_BUSY) {  // Failed to claim interface
+                std::cerr << "Error: Device is currently unavailable.\n";
+            }
+            errlvl = EXIT_FAILURE;
+        }
+    }
+    return errlvl;
+}
+
+void handleSignal(int)  // Handles termination signals
+{
+    quit = 1;
+}
+
+void signalQueue(GF2Device &device, int &errcnt, std::string &errstr)  // Signals queued messages back to back, until the daemon is stopped or an error occurs
+{
+    Keyer keyer(device);
+    while (true) {
+        QueuedMessage entry;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            while (queue.empty() && !stopping) {
+                queueCondition.wait(lock);
+            }
+            if (stopping) {
+                break;
+            }
+            entry = queue.front();
+            queue.pop_front();
+        }
+        std::chrono::steady_clock::time_point dequeued = std::chrono::steady_clock::now();
+        device.refreshGPIOs(errcnt, errstr);  // Other commands may have changed the GPIO pins since the last message
+        std::vector<KeyEvent> schedule = compileMessage(entry.message + " ", 1000 * static_cast<uint64_t>(TUNIT));  // The appended space adds a word space, which separates this message from the next
+        if (errcnt == 0) {
+            keyer.run(schedule, errcnt, errstr);
+            std::cout << std::endl;
+        }
+        std::chrono::steady_clock::time_point signaled = std::chrono::steady_clock::now();
+        long long wait = std::chrono::duration_cast<std::chrono::microseconds>(dequeued - entry.enqueued).count();
+        long long transmit = std::chrono::duration_cast<std::chrono::microseconds>(signaled - dequeued).count();
+        std::ostringstream reply;
+        if (errcnt == 0) {
+            reply << "OK " << wait << " " << transmit << "\n";
+            std::cout << "Message signaled (queue wait: " << wait << "us, transmit: " << transmit << "us)." << std::endl;
+        } else {
+            reply << "ERROR " << (device.disconnected() ? "Device disconnected.\n" : errstr);
+        }
+        writeAll(entry.fd, reply.str());
+        ::close(entry.fd);
+        if (errcnt != 0) {  // If one or more errors are detected, the daemon terminates
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stopping = true;
+            quit = 1;
+            shutdown(listenfd, SHUT_RD);  // This causes poll() to return, so that the daemon can terminate
+            break;
+        }
+    }
+}
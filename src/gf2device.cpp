@@ -1,6 +1,6 @@
-/* GF2 device class - Version 1.0.1
-   Requires CP2130 class version 1.1.0 or later
-   Copyright (c) 2022 Samuel Lourenço
+/* GF2 device class - Version 1.1.0
+   Requires CP2130 class version 1.3.0 or later
+   Copyright (c) 2022-2026 Samuel Lourenço
 
    This library is free software: you can redistribute it and/or modify it
    under the terms of the GNU Lesser General Public License as published by
@@ -21,7 +21,12 @@
 
 // Includes
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
 #include <sstream>
+#include <sys/stat.h>
 #include <unistd.h>
 #include <vector>
 #include "gf2device.h"
@@ -43,9 +48,380 @@ const float MCLK = 80000;         // 80MHz clock
 // Phase conversion constant
 const uint PQUANTUM = 4096;  // Quantum related to the 12-bit phase resolution of the AD9834 waveform generator
 
+// Frame sizes
+const size_t AMPLITUDE_FRAME_SIZE = 2;  // Size of the AD5310 frame that sets the amplitude
+const size_t FREQUENCY_FRAME_SIZE = 4;  // Size of the AD9834 frame that sets a frequency register
+const size_t PHASE_FRAME_SIZE = 2;      // Size of the AD9834 frame that sets a phase register
+
+// Calibration constants
+const int CAL_ATTEMPTS = 20;                                                                  // Number of attempts that must succeed for a settle time to be deemed reliable
+const uint16_t CAL_GPIOS = CP2130::BMGPIO2 | CP2130::BMGPIO3 | CP2130::BMGPIO5 | CP2130::BMGPIO6;  // GPIO pins verified after each attempt (all are expected to be low after clearing the device, while GPIO.4 is the event counter input)
+const double CAL_TOLERANCE = 0.1;                                                             // Maximum relative difference between the measured and the expected count of each attempt
+const int64_t CAL_WINDOW = 20000000;                                                          // Time during which cycles are counted after each attempt (in ns)
+
+// Returns the path of the file where calibrated settle times are stored, one line per device, each containing the serial number and the settle time in us
+static std::string calibrationFilePath()
+{
+    std::string path;
+    const char *cacheHome = std::getenv("XDG_CACHE_HOME");
+    const char *home = std::getenv("HOME");
+    if (cacheHome != nullptr && cacheHome[0] != '\0') {
+        path = std::string(cacheHome) + "/gf2-morse";
+    } else if (home != nullptr && home[0] != '\0') {
+        path = std::string(home) + "/.cache/gf2-morse";
+    }
+    return path.empty() ? path : path + "/settle-times";
+}
+
+// Reads all calibrated settle times, indexed by serial number
+static std::map<std::string, unsigned int> loadSettleTimes()
+{
+    std::map<std::string, unsigned int> settleTimes;
+    std::string path = calibrationFilePath();
+    if (!path.empty()) {
+        std::ifstream file(path.c_str());
+        std::string serial;
+        unsigned int settleTime;
+        while (file >> serial >> settleTime) {
+            settleTimes[serial] = settleTime;
+        }
+    }
+    return settleTimes;
+}
+
+// Stores the given settle time for the device having the given serial number, keeping those of other devices, and returns false in case of failure
+static bool storeSettleTime(const std::string &serial, unsigned int settleTime)
+{
+    bool success = false;
+    std::string path = calibrationFilePath();
+    if (!path.empty()) {
+        std::map<std::string, unsigned int> settleTimes = loadSettleTimes();
+        settleTimes[serial] = settleTime;
+        std::string directory = path.substr(0, path.rfind('/'));
+        mkdir(directory.substr(0, directory.rfind('/')).c_str(), 0755);  // Parent directories are created as needed (errors are ignored, since they already exist in most cases)
+        mkdir(directory.c_str(), 0755);
+        std::string temporaryPath = path + ".tmp";
+        {
+            std::ofstream file(temporaryPath.c_str());
+            for (std::map<std::string, unsigned int>::const_iterator it = settleTimes.begin(); it != settleTimes.end(); ++it) {
+                file << it->first << " " << it->second << "\n";
+            }
+            success = static_cast<bool>(file.flush());
+        }
+        success = success && std::rename(temporaryPath.c_str(), path.c_str()) == 0;  // The file is replaced atomically, so that concurrent readers never see it partially written
+    }
+    return success;
+}
+
+// Converts a serial descriptor to a string, for use as a key in the calibration file (serial numbers only contain ASCII characters)
+static std::string serialString(const std::u16string &descriptor)
+{
+    std::string serial;
+    for (size_t i = 0; i < descriptor.size(); ++i) {
+        serial += descriptor[i] < 0x80 ? static_cast<char>(descriptor[i]) : '?';
+    }
+    return serial;
+}
+
+// Private function used to get the value of the GPIO pin corresponding to the given bitmap
+// If the GPIO cache is enabled, the value is taken from the shadow copy, which is only refreshed from the device if not yet valid
+bool GF2Device::getGPIO(uint16_t bitmap, int &errcnt, std::string &errstr)
+{
+    uint16_t values;
+    if (gpioCacheEnabled_) {
+        if (!gpioCacheValid_) {
+            refreshGPIOs(errcnt, errstr);
+        }
+        values = gpioShadow_;
+    } else {
+        values = cp2130_.getGPIOs(errcnt, errstr);
+    }
+    return (bitmap & values) != 0x0000;
+}
+
+// Private procedure used to set the GPIO pin corresponding to the given bitmap
+void GF2Device::setGPIO(uint16_t bitmap, bool value, int &errcnt, std::string &errstr)
+{
+    setGPIOs(CP2130::BMGPIOS * value, bitmap, errcnt, errstr);
+}
+
+// Private procedure used to set one or more GPIO pins according to the given values and mask bitmaps
+// If the GPIO cache is enabled, pins that are known to have the intended values already are removed from the mask, and the transfer is skipped if none remain
+void GF2Device::setGPIOs(uint16_t bmValues, uint16_t bmMask, int &errcnt, std::string &errstr)
+{
+    if (!gpioCacheEnabled_) {
+        cp2130_.setGPIOs(bmValues, bmMask, errcnt, errstr);
+    } else {
+        if (gpioCacheValid_) {
+            bmMask = static_cast<uint16_t>(bmMask & (bmValues ^ gpioShadow_));  // Only the pins whose values change are written
+        }
+        if (bmMask != 0x0000) {
+            int preverrcnt = errcnt;
+            cp2130_.setGPIOs(bmValues, bmMask, errcnt, errstr);
+            if (errcnt != preverrcnt) {  // The state of the pins is unknown if the transfer fails
+                gpioCacheValid_ = false;
+            } else if (gpioCacheValid_) {  // The shadow copy is updated, as long as it is valid
+                gpioShadow_ = static_cast<uint16_t>((gpioShadow_ & ~bmMask) | (bmValues & bmMask));
+            }
+        }
+    }
+}
+
+// Private procedure used to submit a write to the GPIO pin corresponding to the given bitmap, without waiting for it to complete
+// The transfer is always submitted, so that the callback is invoked exactly once, and the GPIO cache is updated as if it succeeded (refreshGPIOs() should be called if the callback reports otherwise)
+void GF2Device::submitGPIO(uint16_t bitmap, bool value, CP2130::TransferCallback callback, void *userData, int &errcnt, std::string &errstr)
+{
+    cp2130_.submitGPIOs(static_cast<uint16_t>(CP2130::BMGPIOS * value), bitmap, callback, userData, errcnt, errstr);
+    if (gpioCacheEnabled_ && gpioCacheValid_) {
+        gpioShadow_ = static_cast<uint16_t>(value ? gpioShadow_ | bitmap : gpioShadow_ & ~bitmap);
+    }
+}
+
+// Private procedure used to wait for the settle time, as measured by the clock of the device
+void GF2Device::settle()
+{
+    if (settleTime_ > 0) {
+        clock_->sleepFor(1000 * static_cast<int64_t>(settleTime_));
+    }
+}
+
+// Private procedure used to write a single frame to the given SPI channel, without allocating memory
+// This is equivalent to committing a transaction containing a single SPI write
+void GF2Device::writeFrame(uint8_t channel, const uint8_t *frame, size_t length, int &errcnt, std::string &errstr)
+{
+    cp2130_.selectCS(channel, errcnt, errstr);  // Enable the chip select corresponding to the channel, and disable any others
+    settle();  // Wait for the calibrated settle time, in order to prevent possible errors after enabling the chip select (workaround)
+    cp2130_.spiWrite(frame, length, EPOUT, errcnt, errstr);
+    settle();  // Same as above, in order to prevent possible errors while disabling the chip select (workaround)
+    cp2130_.disableCS(channel, errcnt, errstr);  // Disable the previously enabled chip select
+}
+
+// Frame builders used by both GF2Device and GF2Device::Transaction
+// Frames are built into arrays provided by the caller, so that the setters of GF2Device do not allocate memory
+static void buildAmplitudeFrame(float amplitude, uint8_t *frame)
+{
+    uint16_t amplitudeCode = static_cast<uint16_t>(amplitude * AQUANTUM / GF2Device::AMPLITUDE_MAX + 0.5);
+    frame[0] = static_cast<uint8_t>(0x0f & amplitudeCode >> 6);  // Amplitude
+    frame[1] = static_cast<uint8_t>(amplitudeCode << 2);
+}
+
+static void buildFrequencyFrame(bool fsel, uint32_t frequencyCode, uint8_t *frame)
+{
+    frame[0] = static_cast<uint8_t>((fsel ? FREQ1 : FREQ0) | (0x3f & frequencyCode >> 8));  // FREQ0 or FREQ1 register set to the given value, according to the boolean variable "fsel"
+    frame[1] = static_cast<uint8_t>(frequencyCode);
+    frame[2] = static_cast<uint8_t>((fsel ? FREQ1 : FREQ0) | (0x3f & frequencyCode >> 22));
+    frame[3] = static_cast<uint8_t>(frequencyCode >> 14);
+}
+
+static void buildPhaseFrame(bool psel, float phase, uint8_t *frame)
+{
+    float phaseMod = std::fmod(phase, 360);  // Calculate the remainder of the division between the phase and 360
+    uint16_t phaseCode = static_cast<uint16_t>((phaseMod + (phaseMod < 0 ? 360 : 0)) * PQUANTUM / 360 + 0.5);
+    frame[0] = static_cast<uint8_t>((psel ? PHASE1 : PHASE0) | (0x0f & phaseCode >> 8));  // PHASE0 or PHASE1 register set to the given value, according to the boolean variable "psel"
+    frame[1] = static_cast<uint8_t>(phaseCode);
+}
+
+// Private procedure used to record a GPIO operation
+void GF2Device::Transaction::setGPIO(uint16_t bitmap, bool value)
+{
+    Operation operation;
+    operation.spi = false;
+    operation.channel = 0;
+    operation.bmValues = static_cast<uint16_t>(CP2130::BMGPIOS * value);
+    operation.bmMask = bitmap;
+    operations_.push_back(operation);
+}
+
+GF2Device::Transaction::Transaction(GF2Device &device) :
+    device_(device)
+{
+}
+
+// Checks if the transaction has no recorded operations
+bool GF2Device::Transaction::empty() const
+{
+    return operations_.empty();
+}
+
+// Applies all recorded operations, in order, and then clears the transaction
+// Only one chip select is enabled at a time, and it is kept enabled across GPIO operations until all SPI writes are done
+void GF2Device::Transaction::commit(int &errcnt, std::string &errstr)
+{
+    const uint8_t NOCHANNEL = 0xff;
+    uint8_t selected = NOCHANNEL;  // Channel whose chip select is currently enabled
+    size_t nOperations = operations_.size();
+    size_t lastSPI = nOperations;  // Index of the last SPI write, after which the chip select is disabled
+    for (size_t i = 0; i < nOperations; ++i) {
+        if (operations_[i].spi) {
+            lastSPI = i;
+        }
+    }
+    size_t i = 0;
+    while (i < nOperations) {
+        if (!operations_[i].spi) {  // Adjacent GPIO operations are merged, with later operations taking precedence over earlier ones
+            uint16_t bmValues = 0x0000, bmMask = 0x0000;
+            while (i < nOperations && !operations_[i].spi) {
+                bmValues = static_cast<uint16_t>((bmValues & ~operations_[i].bmMask) | (operations_[i].bmValues & operations_[i].bmMask));
+                bmMask = static_cast<uint16_t>(bmMask | operations_[i].bmMask);
+                ++i;
+            }
+            device_.setGPIOs(bmValues, bmMask, errcnt, errstr);
+        } else {  // Adjacent SPI writes are grouped by channel, in order of appearance (the order of writes to the same channel is kept)
+            size_t end = i;
+            while (end < nOperations && operations_[end].spi) {
+                ++end;
+            }
+            for (size_t j = i; j < end; ++j) {
+                if (operations_[j].channel == NOCHANNEL) {  // Already grouped with a previous write
+                    continue;
+                }
+                uint8_t channel = operations_[j].channel;
+                std::vector<uint8_t> data;
+                for (size_t k = j; k < end; ++k) {
+                    if (operations_[k].channel == channel) {
+                        if (channel == 1) {  // The AD5310 has a single register, and only takes one word per frame, so only the last write is kept
+                            data = operations_[k].data;
+                        } else {  // Words written to the AD9834 are simply concatenated, since it takes any number of words per frame
+                            data.insert(data.end(), operations_[k].data.begin(), operations_[k].data.end());
+                        }
+                        operations_[k].channel = NOCHANNEL;
+                    }
+                }
+                if (selected != channel) {
+                    device_.cp2130_.selectCS(channel, errcnt, errstr);  // Enable the chip select corresponding to the channel, and disable any others
+                    device_.settle();  // Wait for the calibrated settle time (100us by default), in order to prevent possible errors after enabling the chip select (workaround)
+                    selected = channel;
+                }
+                device_.cp2130_.spiWrite(data, EPOUT, errcnt, errstr);
+                device_.settle();  // Same as above, in order to prevent possible errors while switching or disabling the chip select (workaround)
+            }
+            if (end > lastSPI) {  // Disable the chip select that remained enabled, before any GPIO operations that follow (chip selects are only kept enabled across GPIO operations that precede another SPI write, as clear() always did)
+                device_.cp2130_.disableCS(selected, errcnt, errstr);
+                selected = NOCHANNEL;
+            }
+            i = end;
+        }
+    }
+    operations_.clear();
+}
+
+// Discards all recorded operations
+void GF2Device::Transaction::discard()
+{
+    operations_.clear();
+}
+
+// Records the selection of the active frequency
+void GF2Device::Transaction::selectFrequency(bool fsel)
+{
+    setGPIO(CP2130::BMGPIO4, fsel);  // GPIO.4 corresponds to the FSEL signal (FSELECT pin on the AD9834 waveform generator)
+}
+
+// Records the selection of the active phase
+void GF2Device::Transaction::selectPhase(bool psel)
+{
+    setGPIO(CP2130::BMGPIO5, psel);  // GPIO.5 corresponds to the PSEL signal (PSELECT pin on the AD9834 waveform generator)
+}
+
+// Records the setting of the amplitude of the generated signal to the given value (in Vpp)
+void GF2Device::Transaction::setAmplitude(float amplitude, int &errcnt, std::string &errstr)
+{
+    if (amplitude < AMPLITUDE_MIN || amplitude > AMPLITUDE_MAX) {
+        ++errcnt;
+        errstr += "In setAmplitude(): Amplitude must be between 0 and 8.\n";  // Program logic error
+    } else {
+        uint8_t frame[AMPLITUDE_FRAME_SIZE];
+        buildAmplitudeFrame(amplitude, frame);
+        spiWrite(1, std::vector<uint8_t>(frame, frame + AMPLITUDE_FRAME_SIZE));  // AD5310 on channel 1
+    }
+}
+
+// Records enabling or disabling the synchronous clock
+void GF2Device::Transaction::setClockEnabled(bool value)
+{
+    setGPIO(CP2130::BMGPIO6, !value);  // GPIO.6 corresponds to the !CMPEN signal (SHDN pin on the TLV3501 comparator)
+}
+
+// Records enabling or disabling the DAC internal to the AD9834 waveform generator
+void GF2Device::Transaction::setDACEnabled(bool value)
+{
+    setGPIO(CP2130::BMGPIO3, !value);  // GPIO.3 corresponds to the SLP signal (SLEEP pin on the AD9834 waveform generator)
+}
+
+// Records the setting of the frequency, selected by the boolean variable "fsel", to the given value (in KHz)
+void GF2Device::Transaction::setFrequency(bool fsel, float frequency, int &errcnt, std::string &errstr)
+{
+    if (frequency < FREQUENCY_MIN || frequency > FREQUENCY_MAX) {
+        ++errcnt;
+        errstr += "In setFrequency(): Frequency must be between 0 and 40000.\n";  // Program logic error
+    } else {
+        spiWrite(0, frequencyFrame(fsel, GF2Device::frequencyCode(frequency)));  // AD9834 on channel 0
+    }
+}
+
+// Records the setting of the frequency, selected by the boolean variable "fsel", to the given 28-bit frequency code (as returned by frequencyCode())
+void GF2Device::Transaction::setFrequencyCode(bool fsel, uint32_t frequencyCode, int &errcnt, std::string &errstr)
+{
+    if (frequencyCode > FREQUENCY_CODE_MAX) {
+        ++errcnt;
+        errstr += "In setFrequencyCode(): Frequency code must not exceed 0x08000000.\n";  // Program logic error
+    } else {
+        spiWrite(0, frequencyFrame(fsel, frequencyCode));  // AD9834 on channel 0
+    }
+}
+
+// Records the setting of the phase, selected by the boolean variable "psel", to the given value (in degrees)
+void GF2Device::Transaction::setPhase(bool psel, float phase)
+{
+    uint8_t frame[PHASE_FRAME_SIZE];
+    buildPhaseFrame(psel, phase, frame);
+    spiWrite(0, std::vector<uint8_t>(frame, frame + PHASE_FRAME_SIZE));  // AD9834 on channel 0
+}
+
+// Records the setting of the waveform of the generated signal to sinusoidal
+void GF2Device::Transaction::setSineWave()
+{
+    spiWrite(0, {0x22, 0x00});  // B28 = 1, PIN/SW = 1, MODE = 0 (sinusoidal waveform)
+}
+
+// Records the setting of the waveform of the generated signal to triangular
+void GF2Device::Transaction::setTriangleWave()
+{
+    spiWrite(0, {0x22, 0x02});  // B28 = 1, PIN/SW = 1, MODE = 1 (triangular waveform)
+}
+
+// Records enabling or disabling the AD9834 waveform generator
+void GF2Device::Transaction::setWaveGenEnabled(bool value)
+{
+    setGPIO(CP2130::BMGPIO2, !value);  // GPIO.2 corresponds to the RST signal (RESET pin on the AD9834 waveform generator)
+}
+
+// Records a write of the given data to the given SPI channel
+void GF2Device::Transaction::spiWrite(uint8_t channel, const std::vector<uint8_t> &data)
+{
+    Operation operation;
+    operation.spi = true;
+    operation.channel = channel;
+    operation.data = data;
+    operation.bmValues = 0x0000;
+    operation.bmMask = 0x0000;
+    operations_.push_back(operation);
+}
+
 GF2Device::GF2Device() :
-    cp2130_()
+    cp2130_(),
+    clock_(&Clock::system()),
+    gpioCacheEnabled_(false),
+    gpioCacheValid_(false),
+    gpioShadow_(0x0000),
+    settleTime_(SETTLE_TIME_DEFAULT)
+{
+}
+
+// Returns the clock used by the device, which is the system clock unless specified otherwise (added in version 1.1.0)
+Clock &GF2Device::clock() const
 {
+    return *clock_;
 }
 
 // Diagnostic function used to verify if the device has been disconnected
@@ -54,51 +430,131 @@ bool GF2Device::disconnected() const
     return cp2130_.disconnected();
 }
 
+// Checks if the GPIO cache is enabled (added in version 1.1.0)
+bool GF2Device::isGPIOCacheEnabled() const
+{
+    return gpioCacheEnabled_;
+}
+
 // Checks if the device is open
 bool GF2Device::isOpen() const
 {
     return cp2130_.isOpen();
 }
 
+// Checks if the device profile is enabled (added in version 1.1.0)
+bool GF2Device::isProfileEnabled() const
+{
+    return cp2130_.isProfileEnabled();
+}
+
+// Returns the chip select settle time currently in use, in microseconds (added in version 1.1.0)
+unsigned int GF2Device::settleTime() const
+{
+    return settleTime_;
+}
+
+// Calibrates the chip select settle time, by repeatedly clearing the device and setting FREQ0 to the given frequency (in KHz) with decreasing settle times, and verifying the outcome of every attempt (added in version 1.1.0)
+// Each attempt is verified by counting the cycles output during a fixed window, through the event counter of the CP2130, since the AD9834 registers cannot be read back
+// This requires a modified device, where GPIO.4 is wired to the synchronous clock output instead of the FSELECT pin (GPIO.4 is reconfigured as an event counter input)
+// The shortest settle time for which all attempts succeed, plus a safety margin, is applied and stored, so that it is applied again whenever the same device is opened
+// If the attempts already fail with the default settle time, the device is deemed not to be modified, and the default settle time is kept
+// Note that the device is left cleared, as after calling clear()
+unsigned int GF2Device::calibrateSettleTime(float frequency, int &errcnt, std::string &errstr)
+{
+    if (frequency <= FREQUENCY_MIN || frequency > CALIBRATION_FREQUENCY_MAX) {
+        ++errcnt;
+        errstr += "In calibrateSettleTime(): Frequency must be greater than 0 and no greater than 2000.\n";  // Program logic error
+        return settleTime_;
+    }
+    double expectedCycles = 1000 * expectedFrequency(frequency) * static_cast<double>(CAL_WINDOW) / 1000000000.0;
+    bool calibrated = false;
+    unsigned int reliableTime = SETTLE_TIME_DEFAULT;
+    for (int candidate = static_cast<int>(SETTLE_TIME_DEFAULT); candidate >= 0 && !disconnected(); candidate -= static_cast<int>(SETTLE_TIME_STEP)) {
+        settleTime_ = static_cast<unsigned int>(candidate);
+        bool reliable = true;
+        for (int i = 0; i < CAL_ATTEMPTS && reliable; ++i) {
+            int attemptErrcnt = 0;
+            std::string attemptErrstr;
+            clear(attemptErrcnt, attemptErrstr);
+            bool csEnabled = cp2130_.getCS(0, attemptErrcnt, attemptErrstr) || cp2130_.getCS(1, attemptErrcnt, attemptErrstr);  // Both chip selects are expected to be disabled
+            uint16_t gpios = cp2130_.getGPIOs(attemptErrcnt, attemptErrstr);  // Read directly from the device, bypassing the GPIO cache
+            setDACEnabled(false, attemptErrcnt, attemptErrstr);  // The counter is only cleared and read while the DAC is disabled, so that no cycles are missed
+            setFrequency(FSEL0, frequency, attemptErrcnt, attemptErrstr);  // This is the write under test, since clear() left FREQ0 set to zero
+            cp2130_.setEventCounter({false, CP2130::PCEVTCNTRRE, 0}, attemptErrcnt, attemptErrstr);
+            setDACEnabled(true, attemptErrcnt, attemptErrstr);
+            int64_t start = clock_->monotonicTime();
+            clock_->sleepFor(CAL_WINDOW);
+            setDACEnabled(false, attemptErrcnt, attemptErrstr);
+            int64_t onTime = clock_->monotonicTime() - start;  // The host sees the window between the completion of both DAC transfers, which is close enough to the time during which the DAC was enabled
+            CP2130::EventCounter evtcntr = cp2130_.getEventCounter(attemptErrcnt, attemptErrstr);
+            double cycles = expectedCycles * static_cast<double>(onTime) / static_cast<double>(CAL_WINDOW);
+            reliable = attemptErrcnt == 0 && !csEnabled && (CAL_GPIOS & gpios) == 0x0000 && !evtcntr.overflow && std::fabs(evtcntr.value - cycles) <= CAL_TOLERANCE * cycles;  // A register that was not written, or written incorrectly, leads to a different frequency
+        }
+        if (!reliable) {
+            break;
+        }
+        calibrated = true;
+        reliableTime = settleTime_;
+    }
+    if (calibrated) {
+        settleTime_ = reliableTime + SETTLE_TIME_MARGIN < SETTLE_TIME_DEFAULT ? reliableTime + SETTLE_TIME_MARGIN : SETTLE_TIME_DEFAULT;
+    } else {
+        settleTime_ = SETTLE_TIME_DEFAULT;
+    }
+    gpioCacheValid_ = false;  // Failed attempts may have left the shadow copy out of date
+    int preverrcnt = errcnt;
+    clear(errcnt, errstr);  // Leave the device in a known state, using the calibrated settle time
+    if (errcnt == preverrcnt) {
+        if (!calibrated) {
+            ++errcnt;
+            errstr += "In calibrateSettleTime(): Could not verify any attempt, even with the default settle time (is GPIO.4 wired to the synchronous clock output?).\n";
+        } else {
+            std::string serial = serialString(getSerialDesc(errcnt, errstr));
+            if (errcnt == preverrcnt && !storeSettleTime(serial, settleTime_)) {
+                ++errcnt;
+                errstr += "In calibrateSettleTime(): Could not store calibration to " + calibrationFilePath() + ".\n";
+            }
+        }
+    }
+    return settleTime_;
+}
+
 // Sets the frequency, phase and amplitude of the generated signal to zero, and sets its waveform to sinusoidal
+// The required operations are applied through a transaction, which reduces the number of transfers
 void GF2Device::clear(int &errcnt, std::string &errstr)
 {
-    setWaveGenEnabled(true, errcnt, errstr);  // This ensures that the RST signal is low prior to resetting the AD9834 waveform generator, since it requires an high to low transition on its RESET pin for the reset to be sampled and acknowledged
-    cp2130_.selectCS(0, errcnt, errstr);  // Enable the chip select corresponding to channel 0, and disable any others
-    usleep(100);  // Wait 100us, in order to prevent possible errors after enabling the chip select (workaround implemented in version 1.0.1)
-    std::vector<uint8_t> setupAD9834 = {
-        0x22, 0x00  // B28 = 1, PIN/SW = 1, MODE = 0 (sinusoidal waveform)
-    };
-    cp2130_.spiWrite(setupAD9834, EPOUT, errcnt, errstr);  // Configure the AD9834 (channel 0) so that it acknowledges reset by pin
-    usleep(100);  // Wait 100us, in order to prevent possible errors, since the following operation sets GPIO.2 high (workaround)
-    setWaveGenEnabled(false, errcnt, errstr);  // Disable and reset the AD9834
+    Transaction transaction(*this);
+    transaction.setWaveGenEnabled(true);  // This ensures that the RST signal is low prior to resetting the AD9834 waveform generator, since it requires an high to low transition on its RESET pin for the reset to be sampled and acknowledged
+    transaction.setSineWave();  // Configure the AD9834 (channel 0) so that it acknowledges reset by pin (B28 = 1, PIN/SW = 1, MODE = 0)
+    transaction.setWaveGenEnabled(false);  // Disable and reset the AD9834
     std::vector<uint8_t> clearAD9834 = {
         FREQ0, 0x00, FREQ0, 0x00,  // FREQ0 register set to zero
         FREQ1, 0x00, FREQ1, 0x00,  // FREQ1 register set to zero
         PHASE0, 0x00,              // PHASE0 register set to zero
         PHASE1, 0x00               // PHASE1 register set to zero
     };
-    cp2130_.spiWrite(clearAD9834, EPOUT, errcnt, errstr);  // Clear all of the AD9834 frequency and phase registers in order to set both generation parameters to zero
-    usleep(100);  // Wait 100us, in order to prevent possible errors while switching the chip select (workaround)
-    cp2130_.selectCS(1, errcnt, errstr);  // Enable the chip select corresponding to channel 1, and disable the one corresponding to channel 0 (the previously selected channel)
-    usleep(100);  // Wait 100us, in order to prevent possible errors after switching the chip select (workaround implemented in version 1.0.1)
-    std::vector<uint8_t> clearAD5310 = {
-        0x00, 0x00  // AD5310 register set to zero
-    };
-    cp2130_.spiWrite(clearAD5310, EPOUT, errcnt, errstr);  // Clear the AD5310 register in order to set the amplitude to zero
-    usleep(100);  // Wait 100us, in order to prevent possible errors while disabling the chip select (workaround)
-    cp2130_.disableCS(1, errcnt, errstr);  // Disable the chip select corresponding to channel 1, which is the only one that is active to this point
-    setDACEnabled(true, errcnt, errstr);  // Enable the DAC that is internal to the AD9834
-    selectFrequency(FSEL0, errcnt, errstr);  // The FREQ0 register defines the frequency of the AD9834
-    selectPhase(PSEL0, errcnt, errstr);  // The PHASE0 register defines the phase of the AD9834
-    setClockEnabled(true, errcnt, errstr);  // Enable the synchronous clock
-    setWaveGenEnabled(true, errcnt, errstr);  // Re-enable the AD9834
+    transaction.spiWrite(0, clearAD9834);  // Clear all of the AD9834 frequency and phase registers in order to set both generation parameters to zero
+    transaction.spiWrite(1, {0x00, 0x00});  // Clear the AD5310 register (channel 1) in order to set the amplitude to zero
+    transaction.setDACEnabled(true);  // Enable the DAC that is internal to the AD9834
+    transaction.selectFrequency(FSEL0);  // The FREQ0 register defines the frequency of the AD9834
+    transaction.selectPhase(PSEL0);  // The PHASE0 register defines the phase of the AD9834
+    transaction.setClockEnabled(true);  // Enable the synchronous clock
+    transaction.setWaveGenEnabled(true);  // Re-enable the AD9834
+    transaction.commit(errcnt, errstr);
 }
 
 // Closes the device safely, if open
 void GF2Device::close()
 {
     cp2130_.close();
+    gpioCacheValid_ = false;
+}
+
+// Gets the native handle of the thread that completes asynchronous transfers, returning false if there is none, as CP2130::eventThreadHandle() does (added in version 1.1.0)
+bool GF2Device::eventThreadHandle(pthread_t &handle)
+{
+    return cp2130_.eventThreadHandle(handle);
 }
 
 // Returns the silicon version of the CP2130 bridge
@@ -107,10 +563,16 @@ CP2130::SiliconVersion GF2Device::getCP2130SiliconVersion(int &errcnt, std::stri
     return cp2130_.getSiliconVersion(errcnt, errstr);
 }
 
+// Gets the event counter of the CP2130 bridge, which counts the pulses applied to GPIO.4 when configured as an EVTCNTR input (added in version 1.1.0)
+CP2130::EventCounter GF2Device::getEventCounter(int &errcnt, std::string &errstr)
+{
+    return cp2130_.getEventCounter(errcnt, errstr);
+}
+
 // Returns the current frequency selection
 bool GF2Device::getFrequencySelection(int &errcnt, std::string &errstr)
 {
-    return cp2130_.getGPIO4(errcnt, errstr);  // GPIO.4 corresponds to the FSEL signal (FSELECT pin on the AD9834 waveform generator)
+    return getGPIO(CP2130::BMGPIO4, errcnt, errstr);  // GPIO.4 corresponds to the FSEL signal (FSELECT pin on the AD9834 waveform generator)
 }
 
 // Returns the hardware revision of the device
@@ -128,7 +590,7 @@ std::u16string GF2Device::getManufacturerDesc(int &errcnt, std::string &errstr)
 // Returns the current phase selection
 bool GF2Device::getPhaseSelection(int &errcnt, std::string &errstr)
 {
-    return cp2130_.getGPIO5(errcnt, errstr);  // GPIO.5 corresponds to the PSEL signal (PSELECT pin on the AD9834 waveform generator)
+    return getGPIO(CP2130::BMGPIO5, errcnt, errstr);  // GPIO.5 corresponds to the PSEL signal (PSELECT pin on the AD9834 waveform generator)
 }
 
 // Gets the product descriptor from the device
@@ -152,75 +614,134 @@ CP2130::USBConfig GF2Device::getUSBConfig(int &errcnt, std::string &errstr)
 // Checks if the synchronous clock is enabled
 bool GF2Device::isClockEnabled(int &errcnt, std::string &errstr)
 {
-    return !cp2130_.getGPIO6(errcnt, errstr);  // GPIO.6 corresponds to the !CMPEN signal (SHDN pin on the TLV3501 comparator)
+    return !getGPIO(CP2130::BMGPIO6, errcnt, errstr);  // GPIO.6 corresponds to the !CMPEN signal (SHDN pin on the TLV3501 comparator)
 }
 
 // Checks if the DAC internal to the AD9834 waveform generator is enabled
 bool GF2Device::isDACEnabled(int &errcnt, std::string &errstr)
 {
-    return !cp2130_.getGPIO3(errcnt, errstr);  // GPIO.3 corresponds to the SLP signal (SLEEP pin on the AD9834 waveform generator)
+    return !getGPIO(CP2130::BMGPIO3, errcnt, errstr);  // GPIO.3 corresponds to the SLP signal (SLEEP pin on the AD9834 waveform generator)
 }
 
 // Checks if the AD9834 waveform generator is enabled
 bool GF2Device::isWaveGenEnabled(int &errcnt, std::string &errstr)
 {
-    return !cp2130_.getGPIO2(errcnt, errstr);  // GPIO.2 corresponds to the RST signal (RESET pin on the AD9834 waveform generator)
+    return !getGPIO(CP2130::BMGPIO2, errcnt, errstr);  // GPIO.2 corresponds to the RST signal (RESET pin on the AD9834 waveform generator)
 }
 
 // Opens a device and assigns its handle
+// The settle time obtained by calibrateSettleTime() is applied if the device was calibrated before
 int GF2Device::open(const std::string &serial)
 {
-    return cp2130_.open(VID, PID, serial);
+    int retval = cp2130_.open(VID, PID, serial);
+    settleTime_ = SETTLE_TIME_DEFAULT;
+    if (retval == SUCCESS) {
+        std::map<std::string, unsigned int> settleTimes = loadSettleTimes();
+        if (!settleTimes.empty()) {  // The serial number is only retrieved if there are calibrated devices
+            int errcnt = 0;
+            std::string errstr;
+            std::string serialNumber = serial.empty() ? serialString(getSerialDesc(errcnt, errstr)) : serial;
+            std::map<std::string, unsigned int>::const_iterator it = settleTimes.find(serialNumber);
+            if (errcnt == 0 && it != settleTimes.end()) {
+                settleTime_ = it->second;
+            }
+        }
+    }
+    return retval;
+}
+
+// Opens a device through the given transport, such as a simulated device (added in version 1.1.0)
+// Since there is no serial number to look up, the default settle time is applied
+int GF2Device::open(CP2130::Transport &transport)
+{
+    settleTime_ = SETTLE_TIME_DEFAULT;
+    return cp2130_.open(transport);
+}
+
+// Issues a GPIO write carrying the same values as setDACEnabled() would, but with an empty mask, so that no pin changes (added in version 1.1.0)
+// The transfer is identical in size and kind to a DAC transition, and it bypasses the GPIO cache, so that its latency can be measured without keying the output
+void GF2Device::probeDACEnabled(bool value, int &errcnt, std::string &errstr)
+{
+    cp2130_.setGPIOs(static_cast<uint16_t>(CP2130::BMGPIOS * !value), 0x0000, errcnt, errstr);  // GPIO.3 corresponds to the SLP signal (SLEEP pin on the AD9834 waveform generator)
+}
+
+// Issues a GPIO write carrying the same value as selectFrequency() would, but with an empty mask, in the same manner as probeDACEnabled() (added in version 1.1.0)
+void GF2Device::probeFrequencySelection(bool fsel, int &errcnt, std::string &errstr)
+{
+    cp2130_.setGPIOs(static_cast<uint16_t>(CP2130::BMGPIO4 * fsel), 0x0000, errcnt, errstr);  // GPIO.4 corresponds to the FSEL signal (FSELECT pin on the AD9834 waveform generator)
+}
+
+// Issues a GPIO write carrying the same value as selectPhase() would, but with an empty mask, in the same manner as probeDACEnabled() (added in version 1.1.0)
+void GF2Device::probePhaseSelection(bool psel, int &errcnt, std::string &errstr)
+{
+    cp2130_.setGPIOs(static_cast<uint16_t>(CP2130::BMGPIO5 * psel), 0x0000, errcnt, errstr);  // GPIO.5 corresponds to the PSEL signal (PSELECT pin on the AD9834 waveform generator)
+}
+
+// Refreshes the shadow copy of the GPIO bitmap from the device, so that any changes made by other processes are taken into account (added in version 1.1.0)
+void GF2Device::refreshGPIOs(int &errcnt, std::string &errstr)
+{
+    int preverrcnt = errcnt;
+    gpioShadow_ = cp2130_.getGPIOs(errcnt, errstr);
+    gpioCacheValid_ = errcnt == preverrcnt;
 }
 
 // Issues a reset to the CP2130, which in effect resets the entire device
 void GF2Device::reset(int &errcnt, std::string &errstr)
 {
     cp2130_.reset(errcnt, errstr);
+    gpioCacheValid_ = false;  // The GPIO pins return to their default values
 }
 
 // Selects the active frequency
 void GF2Device::selectFrequency(bool fsel, int &errcnt, std::string &errstr)
 {
-    cp2130_.setGPIO4(fsel, errcnt, errstr);  // GPIO.4 corresponds to the FSEL signal (FSELECT pin on the AD9834 waveform generator)
+    setGPIO(CP2130::BMGPIO4, fsel, errcnt, errstr);  // GPIO.4 corresponds to the FSEL signal (FSELECT pin on the AD9834 waveform generator)
 }
 
 // Selects the active phase
 void GF2Device::selectPhase(bool psel, int &errcnt, std::string &errstr)
 {
-    cp2130_.setGPIO5(psel, errcnt, errstr);  // GPIO.5 corresponds to the PSEL signal (PSELECT pin on the AD9834 waveform generator)
+    setGPIO(CP2130::BMGPIO5, psel, errcnt, errstr);  // GPIO.5 corresponds to the PSEL signal (PSELECT pin on the AD9834 waveform generator)
 }
 
 // Sets the amplitude of the generated signal to the given value (in Vpp)
+// The frame is written directly instead of being recorded in a transaction, so that no memory is allocated
 void GF2Device::setAmplitude(float amplitude, int &errcnt, std::string &errstr)
 {
     if (amplitude < AMPLITUDE_MIN || amplitude > AMPLITUDE_MAX) {
         ++errcnt;
         errstr += "In setAmplitude(): Amplitude must be between 0 and 8.\n";  // Program logic error
     } else {
-        cp2130_.selectCS(1, errcnt, errstr);  // Enable the chip select corresponding to channel 1, and disable any others
-        usleep(100);  // Wait 100us, in order to prevent possible errors after enabling the chip select (workaround implemented in version 1.0.1)
-        uint16_t amplitudeCode = static_cast<uint16_t>(amplitude * AQUANTUM / AMPLITUDE_MAX + 0.5);
-        std::vector<uint8_t> setAmplitude = {
-            static_cast<uint8_t>(0x0f & amplitudeCode >> 6),  // Amplitude
-            static_cast<uint8_t>(amplitudeCode << 2)
-        };
-        cp2130_.spiWrite(setAmplitude, EPOUT, errcnt, errstr);  // Set the amplitude of the output signal (AD5310 on channel 1)selectPhase
-        usleep(100);  // Wait 100us, in order to prevent possible errors while disabling the chip select (workaround)
-        cp2130_.disableCS(1, errcnt, errstr);  // Disable the previously enabled chip select
+        uint8_t frame[AMPLITUDE_FRAME_SIZE];
+        buildAmplitudeFrame(amplitude, frame);
+        writeFrame(1, frame, AMPLITUDE_FRAME_SIZE, errcnt, errstr);  // AD5310 on channel 1
     }
 }
 
+// Sets the clock used to wait for the settle time, and by any keyer using the device (added in version 1.1.0)
+// A virtual clock should only be used along with a simulated device, since the settle time would not be really waited for
+void GF2Device::setClock(Clock &clock)
+{
+    clock_ = &clock;
+}
+
 // Enables or disables the synchronous clock
 void GF2Device::setClockEnabled(bool value, int &errcnt, std::string &errstr)
 {
-    cp2130_.setGPIO6(!value, errcnt, errstr);  // GPIO.6 corresponds to the !CMPEN signal (SHDN pin on the TLV3501 comparator)
+    setGPIO(CP2130::BMGPIO6, !value, errcnt, errstr);  // GPIO.6 corresponds to the !CMPEN signal (SHDN pin on the TLV3501 comparator)
 }
 
 // Enables or disables the DAC internal to the AD9834 waveform generator
 void GF2Device::setDACEnabled(bool value, int &errcnt, std::string &errstr)
 {
-    cp2130_.setGPIO3(!value, errcnt, errstr);  // GPIO.3 corresponds to the SLP signal (SLEEP pin on the AD9834 waveform generator)
+    setGPIO(CP2130::BMGPIO3, !value, errcnt, errstr);  // GPIO.3 corresponds to the SLP signal (SLEEP pin on the AD9834 waveform generator)
+}
+
+// Sets the event counter of the CP2130 bridge, including the GPIO.4/EVTCNTR pin mode (added in version 1.1.0)
+// Note that this reconfigures GPIO.4 as an input, so that it no longer drives the FSEL signal, which should only be done if the device was modified to route a signal to GPIO.4
+void GF2Device::setEventCounter(const CP2130::EventCounter &evcntr, int &errcnt, std::string &errstr)
+{
+    cp2130_.setEventCounter(evcntr, errcnt, errstr);
 }
 
 // Sets the frequency, selected by the boolean variable "fsel", to the given value (in KHz)
@@ -230,61 +751,45 @@ void GF2Device::setFrequency(bool fsel, float frequency, int &errcnt, std::strin
         ++errcnt;
         errstr += "In setFrequency(): Frequency must be between 0 and 40000.\n";  // Program logic error
     } else {
-        cp2130_.selectCS(0, errcnt, errstr);  // Enable the chip select corresponding to channel 0, and disable any others
-        usleep(100);  // Wait 100us, in order to prevent possible errors after enabling the chip select (workaround implemented in version 1.0.1)
-        uint32_t frequencyCode = static_cast<uint32_t>(frequency * FQUANTUM / MCLK + 0.5);
-        std::vector<uint8_t> setFrequency = {
-            static_cast<uint8_t>((fsel ? FREQ1 : FREQ0) | (0x3f & frequencyCode >> 8)),   // FREQ0 or FREQ1 register set to the given value, according to the boolean variable "fsel"
-            static_cast<uint8_t>(frequencyCode),
-            static_cast<uint8_t>((fsel ? FREQ1 : FREQ0) | (0x3f & frequencyCode >> 22)),
-            static_cast<uint8_t>(frequencyCode >> 14)
-        };
-        cp2130_.spiWrite(setFrequency, EPOUT, errcnt, errstr);  // Set the selected frequency by updating the above registers (AD9834 on channel 0)
-        usleep(100);  // Wait 100us, in order to prevent possible errors while disabling the chip select (workaround)
-        cp2130_.disableCS(0, errcnt, errstr);  // Disable the previously enabled chip select
+        setFrequencyCode(fsel, frequencyCode(frequency), errcnt, errstr);
     }
 }
 
 // Sets the phase, selected by the boolean variable "psel", to the given value (in degrees)
 void GF2Device::setPhase(bool psel, float phase, int &errcnt, std::string &errstr)
 {
-    cp2130_.selectCS(0, errcnt, errstr);  // Enable the chip select corresponding to channel 0, and disable any others
-    usleep(100);  // Wait 100us, in order to prevent possible errors after enabling the chip select (workaround implemented in version 1.0.1)
-    float phaseMod = std::fmod(phase, 360);  // Calculate the remainder of the division between the phase and 360
-    uint16_t phaseCode = static_cast<uint16_t>((phaseMod + (phaseMod < 0 ? 360 : 0)) * PQUANTUM / 360 + 0.5);
-    std::vector<uint8_t> setPhase = {
-        static_cast<uint8_t>((psel ? PHASE1 : PHASE0) | (0x0f & phaseCode >> 8)),   // PHASE0 or PHASE1 register set to the given value, according to the boolean variable "psel"
-        static_cast<uint8_t>(phaseCode)
-    };
-    cp2130_.spiWrite(setPhase, EPOUT, errcnt, errstr);  // Set the selected phase by updating the above registers (AD9834 on channel 0)
-    usleep(100);  // Wait 100us, in order to prevent possible errors while disabling the chip select (workaround)
-    cp2130_.disableCS(0, errcnt, errstr);  // Disable the previously enabled chip select
+    uint8_t frame[PHASE_FRAME_SIZE];
+    buildPhaseFrame(psel, phase, frame);
+    writeFrame(0, frame, PHASE_FRAME_SIZE, errcnt, errstr);  // AD9834 on channel 0
+}
+
+// Enables or disables the device profile, which should be done before opening the device (added in version 1.1.0)
+// When enabled, the configuration and descriptors of the CP2130 are fetched once, when the device is opened, so that getHardwareRevision() and the other getters cost no transfers
+void GF2Device::setProfileEnabled(bool value)
+{
+    cp2130_.setProfileEnabled(value);
 }
 
 // Sets the waveform of the generated signal to sinusoidal
 void GF2Device::setSineWave(int &errcnt, std::string &errstr)
 {
-    cp2130_.selectCS(0, errcnt, errstr);  // Enable the chip select corresponding to channel 0, and disable any others
-    usleep(100);  // Wait 100us, in order to prevent possible errors after enabling the chip select (workaround implemented in version 1.0.1)
-    std::vector<uint8_t> setSineWave = {
-        0x22, 0x00  // B28 = 1, PIN/SW = 1, MODE = 0 (sinusoidal waveform)
-    };
-    cp2130_.spiWrite(setSineWave, EPOUT, errcnt, errstr);  // Set the waveform to sinusoidal (AD9834 on channel 0)
-    usleep(100);  // Wait 100us, in order to prevent possible errors while disabling the chip select (workaround)
-    cp2130_.disableCS(0, errcnt, errstr);  // Disable the previously enabled chip select
+    Transaction transaction(*this);
+    transaction.setSineWave();
+    transaction.commit(errcnt, errstr);
+}
+
+// Sets the observer to which every USB transfer is reported, or nullptr to stop observing transfers (added in version 1.1.0)
+void GF2Device::setTransferObserver(CP2130::TransferObserver *observer)
+{
+    cp2130_.setTransferObserver(observer);
 }
 
 // Sets the waveform of the generated signal to triangular
 void GF2Device::setTriangleWave(int &errcnt, std::string &errstr)
 {
-    cp2130_.selectCS(0, errcnt, errstr);  // Enable the chip select corresponding to channel 0, and disable any others
-    usleep(100);  // Wait 100us, in order to prevent possible errors after enabling the chip select (workaround implemented in version 1.0.1)
-    std::vector<uint8_t> setTriangleWave = {
-        0x22, 0x02  // B28 = 1, PIN/SW = 1, MODE = 1 (triangular waveform)
-    };
-    cp2130_.spiWrite(setTriangleWave, EPOUT, errcnt, errstr);  // Set the waveform to triangular (AD9834 on channel 0)
-    usleep(100);  // Wait 100us, in order to prevent possible errors while disabling the chip select (workaround)
-    cp2130_.disableCS(0, errcnt, errstr);  // Disable the previously enabled chip select
+    Transaction transaction(*this);
+    transaction.setTriangleWave();
+    transaction.commit(errcnt, errstr);
 }
 
 // Sets up channel 0 for communication with the AD9834 waveform generator
@@ -311,10 +816,40 @@ void GF2Device::setupChannel1(int &errcnt, std::string &errstr)
     cp2130_.disableSPIDelays(1, errcnt, errstr);  // Disable all SPI delays for channel 1
 }
 
+// Sets the frequency, selected by the boolean variable "fsel", to the given 28-bit frequency code (added in version 1.1.0)
+// Since no floating point conversion takes place, this is the prefered method for updating frequencies from precomputed tables
+// The frame is built on the stack and written directly, so that retuning does not allocate memory
+void GF2Device::setFrequencyCode(bool fsel, uint32_t frequencyCode, int &errcnt, std::string &errstr)
+{
+    if (frequencyCode > FREQUENCY_CODE_MAX) {
+        ++errcnt;
+        errstr += "In setFrequencyCode(): Frequency code must not exceed 0x08000000.\n";  // Program logic error
+    } else {
+        uint8_t frame[FREQUENCY_FRAME_SIZE];
+        buildFrequencyFrame(fsel, frequencyCode, frame);
+        writeFrame(0, frame, FREQUENCY_FRAME_SIZE, errcnt, errstr);  // AD9834 on channel 0
+    }
+}
+
+// Enables or disables the GPIO cache (added in version 1.1.0)
+// When enabled, the GPIO bitmap is read from the device only once, and then kept up to date by every setter, which also skips writes that would not change the state of its pin
+// Note that changes made by other processes go unnoticed until refreshGPIOs() is called
+void GF2Device::setGPIOCacheEnabled(bool value)
+{
+    gpioCacheEnabled_ = value;
+    gpioCacheValid_ = false;
+}
+
+// Sets the chip select settle time, in microseconds, overriding any calibrated value until the device is opened again (added in version 1.1.0)
+void GF2Device::setSettleTime(unsigned int settleTime)
+{
+    settleTime_ = settleTime;
+}
+
 // Enables or disables the AD9834 waveform generator
 void GF2Device::setWaveGenEnabled(bool value, int &errcnt, std::string &errstr)
 {
-    cp2130_.setGPIO2(!value, errcnt, errstr);  // GPIO.2 corresponds to the RST signal (RESET pin on the AD9834 waveform generator)
+    setGPIO(CP2130::BMGPIO2, !value, errcnt, errstr);  // GPIO.2 corresponds to the RST signal (RESET pin on the AD9834 waveform generator)
 }
 
 // Starts (or restarts) the waveform generation
@@ -335,6 +870,38 @@ void GF2Device::stop(int &errcnt, std::string &errstr)
     }
 }
 
+// Submits a write that enables or disables the DAC internal to the AD9834 waveform generator, without waiting for it to complete (added in version 1.1.0)
+// The transfer is always submitted, so that the callback is invoked exactly once, and the GPIO cache is updated as if it succeeded (refreshGPIOs() should be called if the callback reports otherwise)
+void GF2Device::submitDACEnabled(bool value, CP2130::TransferCallback callback, void *userData, int &errcnt, std::string &errstr)
+{
+    submitGPIO(CP2130::BMGPIO3, !value, callback, userData, errcnt, errstr);  // GPIO.3 corresponds to the SLP signal (SLEEP pin on the AD9834 waveform generator)
+}
+
+// Submits the same write as probeDACEnabled(), without waiting for it to complete, so that the throughput of queued DAC transfers can be measured without keying the output (added in version 1.1.0)
+void GF2Device::submitDACProbe(bool value, CP2130::TransferCallback callback, void *userData, int &errcnt, std::string &errstr)
+{
+    cp2130_.submitGPIOs(static_cast<uint16_t>(CP2130::BMGPIOS * !value), 0x0000, callback, userData, errcnt, errstr);
+}
+
+// Submits the selection of the active frequency register, without waiting for it to complete, in the same manner as submitDACEnabled() (added in version 1.1.0)
+void GF2Device::submitFrequencySelection(bool fsel, CP2130::TransferCallback callback, void *userData, int &errcnt, std::string &errstr)
+{
+    submitGPIO(CP2130::BMGPIO4, fsel, callback, userData, errcnt, errstr);  // GPIO.4 corresponds to the FSEL signal (FSELECT pin on the AD9834 waveform generator)
+}
+
+// Submits the selection of the active phase register, without waiting for it to complete, in the same manner as submitDACEnabled() (added in version 1.1.0)
+void GF2Device::submitPhaseSelection(bool psel, CP2130::TransferCallback callback, void *userData, int &errcnt, std::string &errstr)
+{
+    submitGPIO(CP2130::BMGPIO5, psel, callback, userData, errcnt, errstr);  // GPIO.5 corresponds to the PSEL signal (PSELECT pin on the AD9834 waveform generator)
+}
+
+// Writes the given frame to the AD9834 waveform generator, as returned by frequencyFrame() (added in version 1.1.0)
+// This is equivalent to committing a transaction containing a single SPI write, but the frame is not copied, so that prebuilt frames can be written with minimal overhead
+void GF2Device::writeWaveGenFrame(const std::vector<uint8_t> &frame, int &errcnt, std::string &errstr)
+{
+    writeFrame(0, frame.data(), frame.size(), errcnt, errstr);  // AD9834 on channel 0
+}
+
 // Helper function that returns the expected amplitude from a given amplitude value
 // Note that the function is only valid for values between "AMPLITUDE_MIN" [0] and "AMPLITUDE_MAX" [8]
 float GF2Device::expectedAmplitude(float amplitude)
@@ -356,6 +923,22 @@ float GF2Device::expectedPhase(float phase)
     return std::round((phaseMod + (phaseMod < 0 ? 360 : 0)) * PQUANTUM / 360) * 360 / PQUANTUM;
 }
 
+// Helper function that returns the 28-bit frequency code corresponding to a given frequency value (added in version 1.1.0)
+// Note that the function is only valid for values between "FREQUENCY_MIN" [0] and "FREQUENCY_MAX" [40000]
+uint32_t GF2Device::frequencyCode(float frequency)
+{
+    return static_cast<uint32_t>(frequency * FQUANTUM / MCLK + 0.5);
+}
+
+// Helper function that returns the AD9834 frame that sets the frequency, selected by the boolean variable "fsel", to the given 28-bit frequency code (added in version 1.1.0)
+// The frame can be built once and then written any number of times using writeWaveGenFrame()
+std::vector<uint8_t> GF2Device::frequencyFrame(bool fsel, uint32_t frequencyCode)
+{
+    std::vector<uint8_t> frame(FREQUENCY_FRAME_SIZE);
+    buildFrequencyFrame(fsel, frequencyCode, frame.data());
+    return frame;
+}
+
 // Helper function that returns the hardware revision from a given USB configuration
 std::string GF2Device::hardwareRevision(const CP2130::USBConfig &config)
 {
@@ -1,6 +1,6 @@
-/* GF2 device class - Version 1.0.1
-   Requires CP2130 class version 1.1.0 or later
-   Copyright (c) 2022 Samuel Lourenço
+/* GF2 device class - Version 1.1.0
+   Requires CP2130 class version 1.3.0 or later
+   Copyright (c) 2022-2026 Samuel Lourenço
 
    This library is free software: you can redistribute it and/or modify it
    under the terms of the GNU Lesser General Public License as published by
@@ -26,12 +26,25 @@
 #include <cstdint>
 #include <list>
 #include <string>
+#include <vector>
+#include "clock.h"
 #include "cp2130.h"
 
 class GF2Device
 {
 private:
     CP2130 cp2130_;
+    Clock *clock_;             // Clock used to wait for the settle time, and by any keyer using the device
+    bool gpioCacheEnabled_, gpioCacheValid_;
+    uint16_t gpioShadow_;      // Shadow copy of the GPIO bitmap, only used if the GPIO cache is enabled
+    unsigned int settleTime_;  // Time to wait after enabling a chip select and after each SPI write, in microseconds
+
+    bool getGPIO(uint16_t bitmap, int &errcnt, std::string &errstr);
+    void setGPIO(uint16_t bitmap, bool value, int &errcnt, std::string &errstr);
+    void setGPIOs(uint16_t bmValues, uint16_t bmMask, int &errcnt, std::string &errstr);
+    void settle();
+    void submitGPIO(uint16_t bitmap, bool value, CP2130::TransferCallback callback, void *userData, int &errcnt, std::string &errstr);
+    void writeFrame(uint8_t channel, const uint8_t *frame, size_t length, int &errcnt, std::string &errstr);
 
 public:
     // Class definitions
@@ -54,18 +67,76 @@ public:
     static constexpr float FREQUENCY_MIN = 0;      // Minimum frequency
     static constexpr float FREQUENCY_MAX = 40000;  // Maximum frequency
 
+    // Limit applicable to setFrequencyCode()
+    static const uint32_t FREQUENCY_CODE_MAX = 0x08000000;  // Maximum frequency code, corresponding to "FREQUENCY_MAX"
+
     // Phase selection options applicable to selectPhase() and setPhase()
     static const bool PSEL0 = false;  // Boolean corresponding to phase 0 selection
     static const bool PSEL1 = true;   // Boolean corresponding to phase 1 selection
 
+    // Limit applicable to calibrateSettleTime()
+    static constexpr float CALIBRATION_FREQUENCY_MAX = 2000;  // Maximum frequency, so that the cycles counted during each attempt fit in the 16-bit event counter
+
+    // Values applicable to setSettleTime() and calibrateSettleTime()
+    static const unsigned int SETTLE_TIME_DEFAULT = 100;  // Conservative settle time, used if the device was never calibrated (in us)
+    static const unsigned int SETTLE_TIME_MARGIN = 20;    // Safety margin added to the shortest reliable settle time found during calibration (in us)
+    static const unsigned int SETTLE_TIME_STEP = 10;      // Decrement between the settle times tried during calibration (in us)
+
+    // Records operations to be applied to the device, and then applies them using as few transfers as possible
+    // Adjacent GPIO operations are merged into a single write, while adjacent SPI writes are grouped by channel, so that each chip select is enabled only once
+    // The chip select is disabled right after the last SPI write, so that it is never left enabled while the remaining GPIO operations are applied
+    class Transaction
+    {
+    private:
+        struct Operation {
+            bool spi;                   // True for SPI writes, false for GPIO operations
+            uint8_t channel;            // SPI channel (SPI writes only)
+            std::vector<uint8_t> data;  // Data to be written (SPI writes only)
+            uint16_t bmValues;          // GPIO values bitmap (GPIO operations only)
+            uint16_t bmMask;            // GPIO mask bitmap (GPIO operations only)
+        };
+
+        GF2Device &device_;
+        std::vector<Operation> operations_;
+
+        void setGPIO(uint16_t bitmap, bool value);
+
+    public:
+        explicit Transaction(GF2Device &device);
+
+        bool empty() const;
+
+        void commit(int &errcnt, std::string &errstr);
+        void discard();
+        void selectFrequency(bool fsel);
+        void selectPhase(bool psel);
+        void setAmplitude(float amplitude, int &errcnt, std::string &errstr);
+        void setClockEnabled(bool value);
+        void setDACEnabled(bool value);
+        void setFrequency(bool fsel, float frequency, int &errcnt, std::string &errstr);
+        void setFrequencyCode(bool fsel, uint32_t frequencyCode, int &errcnt, std::string &errstr);
+        void setPhase(bool psel, float phase);
+        void setSineWave();
+        void setTriangleWave();
+        void setWaveGenEnabled(bool value);
+        void spiWrite(uint8_t channel, const std::vector<uint8_t> &data);
+    };
+
     GF2Device();
 
+    Clock &clock() const;
     bool disconnected() const;
+    bool isGPIOCacheEnabled() const;
     bool isOpen() const;
+    bool isProfileEnabled() const;
+    unsigned int settleTime() const;
 
+    unsigned int calibrateSettleTime(float frequency, int &errcnt, std::string &errstr);
     void clear(int &errcnt, std::string &errstr);
     void close();
+    bool eventThreadHandle(pthread_t &handle);
     CP2130::SiliconVersion getCP2130SiliconVersion(int &errcnt, std::string &errstr);
+    CP2130::EventCounter getEventCounter(int &errcnt, std::string &errstr);
     bool getFrequencySelection(int &errcnt, std::string &errstr);
     std::string getHardwareRevision(int &errcnt, std::string &errstr);
     std::u16string getManufacturerDesc(int &errcnt, std::string &errstr);
@@ -77,25 +148,44 @@ public:
     bool isDACEnabled(int &errcnt, std::string &errstr);
     bool isWaveGenEnabled(int &errcnt, std::string &errstr);
     int open(const std::string &serial = std::string());
+    int open(CP2130::Transport &transport);
+    void probeDACEnabled(bool value, int &errcnt, std::string &errstr);
+    void probeFrequencySelection(bool fsel, int &errcnt, std::string &errstr);
+    void probePhaseSelection(bool psel, int &errcnt, std::string &errstr);
+    void refreshGPIOs(int &errcnt, std::string &errstr);
     void reset(int &errcnt, std::string &errstr);
     void selectFrequency(bool fsel, int &errcnt, std::string &errstr);
     void selectPhase(bool psel, int &errcnt, std::string &errstr);
     void setAmplitude(float amplitude, int &errcnt, std::string &errstr);
+    void setClock(Clock &clock);
     void setClockEnabled(bool value, int &errcnt, std::string &errstr);
     void setDACEnabled(bool value, int &errcnt, std::string &errstr);
+    void setEventCounter(const CP2130::EventCounter &evcntr, int &errcnt, std::string &errstr);
     void setFrequency(bool fsel, float frequency, int &errcnt, std::string &errstr);
+    void setFrequencyCode(bool fsel, uint32_t frequencyCode, int &errcnt, std::string &errstr);
+    void setGPIOCacheEnabled(bool value);
     void setPhase(bool psel, float phase, int &errcnt, std::string &errstr);
+    void setProfileEnabled(bool value);
+    void setSettleTime(unsigned int settleTime);
     void setSineWave(int &errcnt, std::string &errstr);
+    void setTransferObserver(CP2130::TransferObserver *observer);
     void setTriangleWave(int &errcnt, std::string &errstr);
     void setupChannel0(int &errcnt, std::string &errstr);
     void setupChannel1(int &errcnt, std::string &errstr);
     void setWaveGenEnabled(bool value, int &errcnt, std::string &errstr);
     void start(int &errcnt, std::string &errstr);
     void stop(int &errcnt, std::string &errstr);
+    void submitDACEnabled(bool value, CP2130::TransferCallback callback, void *userData, int &errcnt, std::string &errstr);
+    void submitDACProbe(bool value, CP2130::TransferCallback callback, void *userData, int &errcnt, std::string &errstr);
+    void submitFrequencySelection(bool fsel, CP2130::TransferCallback callback, void *userData, int &errcnt, std::string &errstr);
+    void submitPhaseSelection(bool psel, CP2130::TransferCallback callback, void *userData, int &errcnt, std::string &errstr);
+    void writeWaveGenFrame(const std::vector<uint8_t> &frame, int &errcnt, std::string &errstr);
 
     static float expectedAmplitude(float amplitude);
     static float expectedFrequency(float frequency);
     static float expectedPhase(float phase);
+    static uint32_t frequencyCode(float frequency);
+    static std::vector<uint8_t> frequencyFrame(bool fsel, uint32_t frequencyCode);
     static std::string hardwareRevision(const CP2130::USBConfig &config);
     static std::list<std::string> listDevices(int &errcnt, std::string &errstr);
 };
@@ -0,0 +1,527 @@
+/* GF2Simulator class - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <cstring>
+#include "gf2device.h"
+#include "gf2simulator.h"
+
+// Definitions
+const int SPI_HEADER_SIZE = 8;             // Size of the command header that precedes the data of SPI bulk transfers
+const int BULK_PACKET_SIZE = 64;           // Maximum packet size of the bulk endpoints (in bytes)
+const int64_t BULK_PACKET_TIME = 50000;    // Time taken to move a full bulk packet at full speed, including protocol overhead (in ns)
+const double MCLK_FREQUENCY = 80000000.0;  // Master clock frequency of the AD9834 waveform generator (in Hz)
+const double FREQUENCY_RESOLUTION = MCLK_FREQUENCY / 268435456.0;  // Frequency step corresponding to one LSB of a frequency register (2^28 steps)
+
+// Bitmaps of the GPIO pins that act as chip selects, indexed by channel
+static const uint16_t CS_BITMAPS[11] = {
+    CP2130::BMGPIO0, CP2130::BMGPIO1, CP2130::BMGPIO2, CP2130::BMGPIO3, CP2130::BMGPIO4, CP2130::BMGPIO5,
+    CP2130::BMGPIO6, CP2130::BMGPIO7, CP2130::BMGPIO8, CP2130::BMGPIO9, CP2130::BMGPIO10
+};
+
+// Writes the given string descriptor to the given buffer, in the same format used by the CP2130 (UTF-16LE, preceded by its length and type)
+static void writeDescriptor(const char *descriptor, unsigned char *data, uint16_t wLength)
+{
+    size_t length = std::strlen(descriptor);
+    std::memset(data, 0, wLength);
+    if (wLength >= 2) {
+        data[0] = static_cast<unsigned char>(2 * length + 2);
+        data[1] = 0x03;
+        for (size_t i = 0; i < length && 2 * i + 3 < wLength; ++i) {
+            data[2 * i + 2] = static_cast<unsigned char>(descriptor[i]);
+        }
+    }
+}
+
+// Private procedure run by the completion thread, which completes asynchronous transfers in order of submission, each once its latency elapses
+// Remaining transfers are completed before the thread stops
+void GF2Simulator::completeTransfers()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        while (queueSize_ == 0 && !stopThread_) {
+            queueCondition_.wait(lock);
+        }
+        if (queueSize_ == 0) {
+            break;
+        }
+        int64_t due = queue_[queueHead_].due;
+        lock.unlock();  // Transfers can be submitted while waiting
+        Clock::system().sleepUntil(due);
+        lock.lock();
+        Request request = queue_[queueHead_];
+        queueHead_ = (queueHead_ + 1) % queue_.size();
+        --queueSize_;
+        CP2130::TransferResult result;
+        if (request.bulk) {
+            int transferred = 0;
+            int status = simulateBulkTransfer(request.endpointAddr, request.data, request.length, &transferred);
+            result = {status < 0 ? status : LIBUSB_TRANSFER_COMPLETED, transferred};
+        } else {
+            int status = simulateControlTransfer(request.endpointAddr, request.bRequest, request.data, static_cast<uint16_t>(request.length));
+            result = {status < 0 ? status : LIBUSB_TRANSFER_COMPLETED, status < 0 ? 0 : status};
+        }
+        lock.unlock();  // The callback may submit further transfers
+        request.callback(result, request.userData);
+        lock.lock();
+    }
+}
+
+// Private function that draws a latency from the given model, and accounts for it in the statistics (in ns)
+int64_t GF2Simulator::drawLatency(const LatencyModel &model)
+{
+    double latency = model.base;  // In us
+    if (model.jitter > 0) {
+        if (model.distribution == NORMAL) {
+            latency = std::normal_distribution<double>(model.base, model.jitter)(random_);
+            latency = latency < 0 ? 0 : latency;
+        } else if (model.distribution == EXPONENTIAL) {
+            latency += std::exponential_distribution<double>(1.0 / model.jitter)(random_);
+        } else {
+            latency += std::uniform_real_distribution<double>(0, model.jitter)(random_);
+        }
+    }
+    int64_t nanoseconds = static_cast<int64_t>(1000 * latency + 0.5);
+    statistics_.busyTime += static_cast<uint64_t>(nanoseconds);
+    return nanoseconds;
+}
+
+// Private function that returns the current time of the simulation, as given by the virtual clock if set, or by the system clock otherwise
+int64_t GF2Simulator::now() const
+{
+    return clock_ != nullptr ? clock_->monotonicTime() : Clock::system().monotonicTime();
+}
+
+// Private function used to schedule a transfer whose latency is drawn from the given model, which must be called while holding "mutex_", returning the time at which it completes (in ns)
+// A control transfer cannot start before the previous one completes, as EP0 handles one request at a time, and a bulk transfer cannot start before the packets of the previous one on the same endpoint are moved, as the CP2130 handles one bulk command at a time
+int64_t GF2Simulator::scheduleTransfer(bool bulk, uint8_t endpointAddr, int length, const LatencyModel &model)
+{
+    int64_t time = now();
+    int64_t latency = drawLatency(model);
+    int endpoint = !bulk ? 0 : endpointAddr >= 0x80 ? 2 : 1;
+    int64_t start = time > endpointFree_[endpoint] ? time : endpointFree_[endpoint];
+    int64_t due;
+    if (bulk) {
+        int64_t packets = length > BULK_PACKET_SIZE ? (length + BULK_PACKET_SIZE - 1) / BULK_PACKET_SIZE : 1;
+        int64_t service = packets * BULK_PACKET_TIME < latency ? packets * BULK_PACKET_TIME : latency;  // The packets are moved within the latency of the transfer, which bounds its service time
+        endpointFree_[endpoint] = start + service;
+        due = time + latency > start + service ? time + latency : start + service;
+    } else {
+        due = start + latency;
+        endpointFree_[endpoint] = due;
+    }
+    return due;
+}
+
+// Private function used to simulate a bulk transfer, once its latency elapsed, which must be called while holding "mutex_"
+// OUT transfers carry SPI commands, whose data is routed to the enabled chip selects, while IN transfers return the data requested by the preceding Read or WriteRead command (always zeros, since neither device drives MISO)
+int GF2Simulator::simulateBulkTransfer(uint8_t endpointAddr, unsigned char *data, int length, int *transferred)
+{
+    ++statistics_.bulkTransfers;
+    updateEventCounter();  // Any change to the frequency registers only applies to subsequent cycles
+    int result = LIBUSB_SUCCESS;
+    int bytesTransferred = 0;
+    if (endpointAddr >= 0x80) {  // IN transfer
+        bytesTransferred = static_cast<uint32_t>(length) < pendingRead_ ? length : static_cast<int>(pendingRead_);
+        std::memset(data, 0, static_cast<size_t>(bytesTransferred));
+        pendingRead_ -= static_cast<uint32_t>(bytesTransferred);
+    } else if (pendingWrite_ > 0) {  // Continuation of the payload of a previous command, which may span several transfers
+        uint32_t available = static_cast<uint32_t>(length);
+        uint32_t bytesWritten = pendingWrite_ < available ? pendingWrite_ : available;
+        writeSPI(data, bytesWritten);
+        pendingWrite_ -= bytesWritten;
+        bytesTransferred = length;
+    } else if (length < SPI_HEADER_SIZE) {
+        result = LIBUSB_ERROR_PIPE;  // Malformed command
+    } else {
+        uint32_t payload = static_cast<uint32_t>(data[7] << 24 | data[6] << 16 | data[5] << 8 | data[4]);
+        if (data[2] == CP2130::WRITE || data[2] == CP2130::WRITEREAD) {
+            uint32_t available = static_cast<uint32_t>(length - SPI_HEADER_SIZE);
+            uint32_t bytesWritten = payload < available ? payload : available;
+            writeSPI(data + SPI_HEADER_SIZE, bytesWritten);
+            pendingWrite_ = payload - bytesWritten;
+        }
+        if (data[2] != CP2130::WRITE) {  // Read, WriteRead and ReadWithRTR commands are followed by IN transfers
+            pendingRead_ = payload;
+        }
+        bytesTransferred = length;
+    }
+    if (transferred != nullptr) {
+        *transferred = bytesTransferred;
+    }
+    return result;
+}
+
+// Private function used to simulate a control transfer, once its latency elapsed, which must be called while holding "mutex_"
+// Requests that do not affect the simulated state are accepted, and unmodeled Device-to-Host requests return zeros
+int GF2Simulator::simulateControlTransfer(uint8_t bmRequestType, uint8_t bRequest, unsigned char *data, uint16_t wLength)
+{
+    ++statistics_.controlTransfers;
+    updateEventCounter();  // Likewise, any change to the GPIOs only applies from this point on
+    if (bmRequestType == CP2130::GET && wLength > 0) {
+        std::memset(data, 0, wLength);
+        if (bRequest == CP2130::GET_GPIO_VALUES) {
+            data[0] = static_cast<unsigned char>(gpios_ >> 8);
+            data[1] = static_cast<unsigned char>(gpios_);
+        } else if (bRequest == CP2130::GET_GPIO_CHIP_SELECT) {
+            data[0] = data[2] = static_cast<unsigned char>(csEnabled_ >> 8);
+            data[1] = data[3] = static_cast<unsigned char>(csEnabled_);
+        } else if (bRequest == CP2130::GET_SPI_WORD) {
+            std::memcpy(data, spiWords_, sizeof(spiWords_));
+        } else if (bRequest == CP2130::GET_USB_CONFIG) {
+            const unsigned char config[CP2130::GET_USB_CONFIG_WLEN] = {
+                static_cast<uint8_t>(GF2Device::VID), static_cast<uint8_t>(GF2Device::VID >> 8),
+                static_cast<uint8_t>(GF2Device::PID), static_cast<uint8_t>(GF2Device::PID >> 8),
+                0x32,  // Maximum power consumption of 100mA
+                0x00,  // Bus-powered
+                0x02, 0x00,  // Release version corresponding to hardware revision "A"
+                CP2130::PRIOWRITE
+            };
+            std::memcpy(data, config, sizeof(config));
+        } else if (bRequest == CP2130::GET_MANUFACTURING_STRING_1) {
+            writeDescriptor("Bloguetronica", data, wLength);
+        } else if (bRequest == CP2130::GET_PRODUCT_STRING_1) {
+            writeDescriptor("GF2 Function Generator (simulated)", data, wLength);
+        } else if (bRequest == CP2130::GET_SERIAL_STRING) {
+            writeDescriptor("SIMULATED", data, wLength);
+        } else if (bRequest == CP2130::GET_LOCK_BYTE) {
+            data[0] = data[1] = 0xff;  // OTP ROM not locked
+        } else if (bRequest == CP2130::GET_EVENT_COUNTER && wLength >= CP2130::GET_EVENT_COUNTER_WLEN) {
+            data[0] = static_cast<unsigned char>((evtcntrOverflow_ ? 0x80 : 0x00) | evtcntrMode_);
+            data[1] = static_cast<unsigned char>(evtcntrValue_ >> 8);
+            data[2] = static_cast<unsigned char>(evtcntrValue_);
+        }
+    } else if (bmRequestType == CP2130::SET) {
+        if (bRequest == CP2130::SET_GPIO_VALUES && wLength >= CP2130::SET_GPIO_VALUES_WLEN) {
+            uint16_t bmValues = static_cast<uint16_t>(data[0] << 8 | data[1]);
+            uint16_t bmMask = static_cast<uint16_t>(CP2130::BMGPIOS & (data[2] << 8 | data[3]));
+            gpios_ = static_cast<uint16_t>((gpios_ & ~bmMask) | (bmValues & bmMask));
+        } else if (bRequest == CP2130::SET_GPIO_CHIP_SELECT && wLength >= CP2130::SET_GPIO_CHIP_SELECT_WLEN && data[0] <= 10) {
+            uint16_t channelBitmap = static_cast<uint16_t>(0x0001 << data[0]);
+            if (data[1] == 0x00) {  // Chip select disabled
+                csEnabled_ = static_cast<uint16_t>(csEnabled_ & ~channelBitmap);
+            } else if (data[1] == 0x01) {  // Chip select enabled
+                csEnabled_ = static_cast<uint16_t>(csEnabled_ | channelBitmap);
+            } else {  // Chip select enabled, and all the others disabled
+                csEnabled_ = channelBitmap;
+            }
+            for (int channel = 0; channel < 2; ++channel) {  // Chip selects are active low, and only GPIO.0 and GPIO.1 are configured as such (the remaining pins are ordinary GPIOs, which are not affected)
+                bool enabled = (0x0001 << channel & csEnabled_) != 0x0000;
+                gpios_ = static_cast<uint16_t>(enabled ? gpios_ & ~CS_BITMAPS[channel] : gpios_ | CS_BITMAPS[channel]);
+                if (!enabled) {
+                    pendingByte_[channel] = -1;  // An incomplete word is discarded when the chip select is disabled
+                }
+            }
+        } else if (bRequest == CP2130::SET_SPI_WORD && wLength >= CP2130::SET_SPI_WORD_WLEN && data[0] <= 10) {
+            spiWords_[data[0]] = data[1];
+        } else if (bRequest == CP2130::SET_EVENT_COUNTER && wLength >= CP2130::SET_EVENT_COUNTER_WLEN) {
+            evtcntrMode_ = static_cast<uint8_t>(0x07 & data[0]);
+            evtcntrMode_ = evtcntrMode_ >= CP2130::PCEVTCNTRRE ? evtcntrMode_ : 0;  // Other modes turn GPIO.4 into an ordinary GPIO
+            evtcntrValue_ = static_cast<uint16_t>(data[1] << 8 | data[2]);
+            evtcntrOverflow_ = false;
+            evtcntrPhase_ = 0;
+        } else if (bRequest == CP2130::SET_RTR_STOP && wLength >= CP2130::SET_RTR_STOP_WLEN && data[0] != 0x00) {
+            pendingRead_ = 0;  // Aborting a ReadWithRTR command discards the data not yet read
+        }
+    }
+    return wLength;
+}
+
+// Private procedure used to queue an asynchronous transfer, which completes once a latency drawn from the given model elapses, but never before the previously queued transfers
+void GF2Simulator::submitRequest(const Request &request, const LatencyModel &model)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!thread_.joinable()) {
+        stopThread_ = false;
+        thread_ = std::thread(&GF2Simulator::completeTransfers, this);
+    }
+    if (queueSize_ == queue_.size()) {  // The ring is full, so it is doubled, keeping the order of the queued transfers
+        std::vector<Request> queue(2 * queue_.size());
+        for (size_t i = 0; i < queueSize_; ++i) {
+            queue[i] = queue_[(queueHead_ + i) % queue_.size()];
+        }
+        queue_.swap(queue);
+        queueHead_ = 0;
+    }
+    Request &queued = queue_[(queueHead_ + queueSize_) % queue_.size()];
+    queued = request;
+    queued.due = scheduleTransfer(request.bulk, request.endpointAddr, request.length, model);
+    if (queued.due < lastDue_) {  // Transfers complete in order of submission
+        queued.due = lastDue_;
+    }
+    lastDue_ = queued.due;
+    ++queueSize_;
+    queueCondition_.notify_one();
+}
+
+// Private procedure used to count the events applied to GPIO.4 since the last update
+// When GPIO.4 is configured as an EVTCNTR input, it is assumed to be wired to the synchronous clock output, which toggles at the selected frequency as long as the waveform generator is running, its DAC is enabled and the comparator is enabled
+void GF2Simulator::updateEventCounter()
+{
+    int64_t time = now();
+    bool running = (gpios_ & (CP2130::BMGPIO2 | CP2130::BMGPIO3 | CP2130::BMGPIO6)) == 0x0000;  // RST, SLP and !CMPEN low
+    if (evtcntrMode_ >= CP2130::PCEVTCNTRRE && running && time > evtcntrTime_) {
+        bool fsel = (0x0200 & control_) != 0x0000 ? false : (0x0800 & control_) != 0x0000;  // FSELECT pin is tied low, since GPIO.4 no longer drives it
+        evtcntrPhase_ += FREQUENCY_RESOLUTION * frequencies_[fsel ? 1 : 0] * static_cast<double>(time - evtcntrTime_) / 1000000000.0;
+        uint64_t events = static_cast<uint64_t>(evtcntrPhase_);  // One edge or pulse of each kind per cycle
+        evtcntrPhase_ -= static_cast<double>(events);
+        uint64_t value = evtcntrValue_ + events;
+        evtcntrOverflow_ = evtcntrOverflow_ || value > 0xffff;
+        evtcntrValue_ = static_cast<uint16_t>(value);
+    }
+    evtcntrTime_ = time;
+}
+
+// Private procedure used to wait until the given time, which must be called while holding "mutex_"
+void GF2Simulator::waitUntil(int64_t time)
+{
+    if (clock_ != nullptr) {  // Transfers take no real time when a virtual clock is used
+        int64_t duration = time - clock_->monotonicTime();
+        if (duration > 0) {
+            clock_->advance(duration);
+        }
+    } else {
+        Clock::system().sleepUntil(time);
+    }
+}
+
+// Private procedure used to process a word written to the AD5310 DAC (channel 1)
+void GF2Simulator::writeAD5310(uint16_t word)
+{
+    dacCode_ = static_cast<uint16_t>(0x03ff & word >> 2);  // Bits 11:2 hold the input register, while bits 13:12 hold the power-down mode (always normal operation)
+}
+
+// Private procedure used to process a word written to the AD9834 waveform generator (channel 0)
+void GF2Simulator::writeAD9834(uint16_t word)
+{
+    uint16_t address = static_cast<uint16_t>(0xc000 & word);
+    if (address == 0x0000) {  // Control register
+        control_ = word;
+        msbNext_ = false;
+    } else if (address == 0xc000) {  // PHASE0 or PHASE1 register, selected by bit 13
+        phases_[(0x2000 & word) != 0x0000 ? 1 : 0] = static_cast<uint16_t>(0x0fff & word);
+    } else {  // FREQ0 or FREQ1 register
+        uint32_t &frequency = frequencies_[address == 0x8000 ? 1 : 0];
+        uint32_t bits = 0x3fff & word;
+        bool msb;
+        if ((0x2000 & control_) != 0x0000) {  // B28 = 1, so that consecutive writes carry the 14 LSBs and then the 14 MSBs
+            msb = msbNext_;
+            msbNext_ = !msbNext_;
+        } else {  // B28 = 0, so that HLB selects which half is written
+            msb = (0x1000 & control_) != 0x0000;
+        }
+        frequency = msb ? (0x00003fff & frequency) | bits << 14 : (0x0fffc000 & frequency) | bits;
+    }
+}
+
+// Private procedure used to route the given SPI data to the devices whose chip select is enabled
+void GF2Simulator::writeSPI(const unsigned char *data, uint32_t length)
+{
+    statistics_.spiBytes += length;
+    for (int channel = 0; channel < 2; ++channel) {
+        if ((0x0001 << channel & csEnabled_) != 0x0000) {
+            for (uint32_t i = 0; i < length; ++i) {  // Both devices take 16-bit words, MSB first
+                if (pendingByte_[channel] < 0) {
+                    pendingByte_[channel] = data[i];
+                } else {
+                    uint16_t word = static_cast<uint16_t>(pendingByte_[channel] << 8 | data[i]);
+                    pendingByte_[channel] = -1;
+                    if (channel == 0) {
+                        writeAD9834(word);
+                    } else {
+                        writeAD5310(word);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// The simulated device starts as if gf2-start had been invoked, with the waveform generator running and its DAC disabled
+GF2Simulator::GF2Simulator() :
+    queue_(64),  // Enough for the transfers usually kept in flight, so that the ring seldom grows
+    queueHead_(0),
+    queueSize_(0),
+    lastDue_(0),
+    endpointFree_(),
+    stopThread_(false),
+    random_(0),  // Fixed seed, so that simulations are reproducible
+    clock_(nullptr),
+    bulkLatency_({0, 0, UNIFORM}),
+    controlLatency_({0, 0, UNIFORM}),
+    statistics_({0, 0, 0, 0}),
+    gpios_(static_cast<uint16_t>(CP2130::BMGPIOS & ~(CP2130::BMGPIO2 | CP2130::BMGPIO6))),  // RST and !CMPEN low, SLP high, and both chip selects disabled
+    csEnabled_(0x0000),
+    spiWords_(),
+    pendingRead_(0),
+    pendingWrite_(0),
+    pendingByte_(),
+    control_(0x2200),  // B28 = 1, PIN/SW = 1
+    frequencies_(),
+    phases_(),
+    msbNext_(false),
+    dacCode_(0),
+    evtcntrMode_(0),
+    evtcntrValue_(0),
+    evtcntrOverflow_(false),
+    evtcntrPhase_(0),
+    evtcntrTime_(0)
+{
+    pendingByte_[0] = pendingByte_[1] = -1;
+}
+
+// The completion thread, if started, is stopped once any queued transfers are completed
+GF2Simulator::~GF2Simulator()
+{
+    if (thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopThread_ = true;
+            queueCondition_.notify_one();
+        }
+        thread_.join();
+    }
+}
+
+// Returns the value of the AD5310 input register, which sets the amplitude
+uint16_t GF2Simulator::amplitudeCode() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dacCode_;
+}
+
+// Returns the value of the AD9834 control register
+uint16_t GF2Simulator::controlWord() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return control_;
+}
+
+// Returns the value of the AD9834 frequency register selected by the boolean variable "fsel"
+uint32_t GF2Simulator::frequencyCode(bool fsel) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return frequencies_[fsel ? 1 : 0];
+}
+
+// Returns the value of all GPIO pins, in bitmap format
+uint16_t GF2Simulator::gpios() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return gpios_;
+}
+
+// Checks if the calling thread is the completion thread, from which the callbacks of asynchronous transfers are invoked
+bool GF2Simulator::isCompletionThread() const
+{
+    return std::this_thread::get_id() == thread_.get_id();
+}
+
+// Returns the value of the AD9834 phase register selected by the boolean variable "psel"
+uint16_t GF2Simulator::phaseCode(bool psel) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return phases_[psel ? 1 : 0];
+}
+
+// Returns the transfer statistics accumulated since the simulated device was created, or since resetStatistics() was last called
+GF2Simulator::Statistics GF2Simulator::statistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+// Simulates a bulk transfer, synchronously
+// OUT transfers carry SPI commands, whose data is routed to the enabled chip selects, while IN transfers return the data requested by the preceding Read or WriteRead command
+int GF2Simulator::bulkTransfer(uint8_t endpointAddr, unsigned char *data, int length, int *transferred)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    waitUntil(scheduleTransfer(true, endpointAddr, length, bulkLatency_));
+    return simulateBulkTransfer(endpointAddr, data, length, transferred);
+}
+
+// Simulates a control transfer, synchronously
+int GF2Simulator::controlTransfer(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength)
+{
+    (void)wValue;
+    (void)wIndex;
+    std::lock_guard<std::mutex> lock(mutex_);
+    waitUntil(scheduleTransfer(false, bmRequestType, wLength, controlLatency_));
+    return simulateControlTransfer(bmRequestType, bRequest, data, wLength);
+}
+
+// Resets the transfer statistics
+void GF2Simulator::resetStatistics()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    statistics_ = {0, 0, 0, 0};
+}
+
+// Sets the latency model applicable to bulk transfers (by default, transfers take no time)
+void GF2Simulator::setBulkLatency(const LatencyModel &model)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    bulkLatency_ = model;
+}
+
+// Sets the virtual clock to be advanced by the latency of each transfer, instead of sleeping for it (nullptr restores real sleeps)
+void GF2Simulator::setClock(VirtualClock *clock)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    clock_ = clock;
+    endpointFree_[0] = endpointFree_[1] = endpointFree_[2] = 0;  // Times taken from another clock no longer apply
+}
+
+// Sets the latency model applicable to control transfers (by default, transfers take no time)
+void GF2Simulator::setControlLatency(const LatencyModel &model)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    controlLatency_ = model;
+}
+
+// Submits a bulk transfer, which is completed by the completion thread once its latency elapses (or before this returns, if a virtual clock is used)
+void GF2Simulator::submitBulkTransfer(uint8_t endpointAddr, unsigned char *data, int length, CP2130::TransferCallback callback, void *userData)
+{
+    bool virtualTime;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        virtualTime = clock_ != nullptr;
+    }
+    if (virtualTime) {
+        CP2130::Transport::submitBulkTransfer(endpointAddr, data, length, callback, userData);
+    } else {
+        submitRequest({true, endpointAddr, 0, 0, 0, data, length, callback, userData, 0}, bulkLatency_);
+    }
+}
+
+// Submits a control transfer, which is completed by the completion thread once its latency elapses (or before this returns, if a virtual clock is used)
+void GF2Simulator::submitControlTransfer(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength, CP2130::TransferCallback callback, void *userData)
+{
+    bool virtualTime;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        virtualTime = clock_ != nullptr;
+    }
+    if (virtualTime) {
+        CP2130::Transport::submitControlTransfer(bmRequestType, bRequest, wValue, wIndex, data, wLength, callback, userData);
+    } else {
+        submitRequest({false, bmRequestType, bRequest, wValue, wIndex, data, wLength, callback, userData, 0}, controlLatency_);
+    }
+}
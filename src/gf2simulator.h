@@ -0,0 +1,139 @@
+/* GF2Simulator class - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef GF2SIMULATOR_H
+#define GF2SIMULATOR_H
+
+// Includes
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "clock.h"
+#include "cp2130.h"
+
+// Simulated GF2 Function Generator, which can be opened in place of a physical device through GF2Device::open(CP2130::Transport &)
+// It models the GPIO pins and chip selects of the CP2130, as well as the registers of the AD9834 waveform generator and the AD5310 DAC, and delays each transfer according to a configurable latency model
+// Each transfer occupies its endpoint for part of its latency: control transfers hold EP0 until they complete, so they never overlap, whereas bulk transfers only hold their endpoint while their packets are being moved, so that the remaining latency of bulk transfers in flight overlaps
+// Asynchronous transfers are completed by a dedicated thread, once their latency elapses, and always in order of submission
+// If a virtual clock is used, asynchronous transfers are completed before being submitted instead, since virtual time only advances when something sleeps on it
+class GF2Simulator : public CP2130::Transport
+{
+public:
+    // Distributions applicable to LatencyModel
+    static const int UNIFORM = 0;      // Latency uniformly distributed between "base" and "base" plus "jitter"
+    static const int NORMAL = 1;       // Latency normally distributed around "base", having "jitter" as standard deviation (negative values are clipped to zero)
+    static const int EXPONENTIAL = 2;  // Latency equal to "base" plus an exponentially distributed delay, having "jitter" as mean (long tail)
+
+    struct LatencyModel {
+        unsigned int base;    // Base latency (in us)
+        unsigned int jitter;  // Jitter (in us), whose meaning depends on the distribution
+        int distribution;     // Distribution of the latency (UNIFORM, NORMAL or EXPONENTIAL)
+    };
+
+    struct Statistics {
+        size_t controlTransfers;  // Number of control transfers
+        size_t bulkTransfers;     // Number of bulk transfers
+        size_t spiBytes;          // Number of bytes written to the SPI bus
+        uint64_t busyTime;        // Sum of the simulated transfer latencies (in ns)
+    };
+
+private:
+    struct Request {
+        bool bulk;                         // True for bulk transfers, false for control transfers
+        uint8_t endpointAddr;              // Endpoint address (bulk transfers), or request type (control transfers)
+        uint8_t bRequest;                  // Request (control transfers only)
+        uint16_t wValue;                   // Value (control transfers only)
+        uint16_t wIndex;                   // Index (control transfers only)
+        unsigned char *data;               // Data to be transferred
+        int length;                        // Length of the data
+        CP2130::TransferCallback callback;
+        void *userData;
+        int64_t due;                       // Time at which the transfer completes (in ns)
+    };
+
+    mutable std::mutex mutex_;  // Serializes transfers, as the USB bus of a physical device would
+    std::condition_variable queueCondition_;
+    std::vector<Request> queue_;  // Asynchronous transfers yet to be completed, used as a ring that only grows if needed
+    size_t queueHead_, queueSize_;
+    int64_t lastDue_;             // Time at which the last asynchronous transfer completes (in ns)
+    int64_t endpointFree_[3];     // Time from which EP0, the bulk OUT endpoint and the bulk IN endpoint are free to start another transfer (in ns)
+    bool stopThread_;
+    std::thread thread_;          // Completion thread, started on the first asynchronous transfer
+    std::mt19937 random_;
+    VirtualClock *clock_;     // Virtual clock advanced by the latency of each transfer, or nullptr if transfers take real time
+    LatencyModel bulkLatency_, controlLatency_;
+    Statistics statistics_;
+    uint16_t gpios_;          // GPIO bitmap, as returned by CP2130::getGPIOs()
+    uint16_t csEnabled_;      // Bitmap of enabled chip selects (bit n corresponds to channel n)
+    uint8_t spiWords_[11];    // SPI control word of each channel
+    uint32_t pendingRead_;    // Number of bytes to be returned by the next bulk IN transfer
+    uint32_t pendingWrite_;   // Number of payload bytes of the current Write or WriteRead command that were not received yet
+    int pendingByte_[2];      // First byte of a 16-bit word being written to channel 0 or 1, or -1 if none
+    uint16_t control_;        // AD9834 control register
+    uint32_t frequencies_[2]; // AD9834 FREQ0 and FREQ1 registers
+    uint16_t phases_[2];      // AD9834 PHASE0 and PHASE1 registers
+    bool msbNext_;            // True if the next write to a frequency register carries its 14 MSBs (AD9834 in 28-bit mode)
+    uint16_t dacCode_;        // AD5310 input register (10 bits)
+    uint8_t evtcntrMode_;     // GPIO.4/EVTCNTR pin mode, or zero if GPIO.4 is an output driving the FSEL signal
+    uint16_t evtcntrValue_;   // Event count value
+    bool evtcntrOverflow_;    // Event counter overflow flag
+    double evtcntrPhase_;     // Fraction of a cycle of the synchronous clock elapsed since the last counted event
+    int64_t evtcntrTime_;     // Time up to which the event counter was updated (in ns)
+
+    void completeTransfers();
+    int64_t drawLatency(const LatencyModel &model);
+    int64_t now() const;
+    int64_t scheduleTransfer(bool bulk, uint8_t endpointAddr, int length, const LatencyModel &model);
+    int simulateBulkTransfer(uint8_t endpointAddr, unsigned char *data, int length, int *transferred);
+    int simulateControlTransfer(uint8_t bmRequestType, uint8_t bRequest, unsigned char *data, uint16_t wLength);
+    void submitRequest(const Request &request, const LatencyModel &model);
+    void updateEventCounter();
+    void waitUntil(int64_t time);
+    void writeAD5310(uint16_t word);
+    void writeAD9834(uint16_t word);
+    void writeSPI(const unsigned char *data, uint32_t length);
+
+public:
+    GF2Simulator();
+    ~GF2Simulator();
+
+    uint16_t amplitudeCode() const;
+    uint16_t controlWord() const;
+    uint32_t frequencyCode(bool fsel) const;
+    uint16_t gpios() const;
+    bool isCompletionThread() const override;
+    uint16_t phaseCode(bool psel) const;
+    Statistics statistics() const;
+
+    int bulkTransfer(uint8_t endpointAddr, unsigned char *data, int length, int *transferred) override;
+    int controlTransfer(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength) override;
+    void resetStatistics();
+    void setBulkLatency(const LatencyModel &model);
+    void setClock(VirtualClock *clock);
+    void setControlLatency(const LatencyModel &model);
+    void submitBulkTransfer(uint8_t endpointAddr, unsigned char *data, int length, CP2130::TransferCallback callback, void *userData) override;
+    void submitControlTransfer(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength, CP2130::TransferCallback callback, void *userData) override;
+};
+
+#endif  // GF2SIMULATOR_H
@@ -0,0 +1,78 @@
+/* Frequency hopping functions - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <fstream>
+#include "hopping.h"
+
+// Compiles the given sequence of frequency codes into a schedule of timed events, each frequency lasting for the given dwell time (in nanoseconds)
+// The FREQ0 and FREQ1 registers are used alternately, so that the next frequency is written to the inactive register while the active one is being generated
+// Since hops are done by toggling FSEL alone, they take a single transfer each, and are phase continuous
+std::vector<KeyEvent> compileHops(const std::vector<uint32_t> &codes, uint64_t dwell)
+{
+    std::vector<KeyEvent> schedule;
+    size_t ncodes = codes.size();
+    if (ncodes > 0) {
+        schedule.push_back({0, GF2Device::FSEL0, '\0', KEY_STAGE, codes[0]});  // The first frequency is written to FREQ0 before it is selected
+        schedule.push_back({0, GF2Device::FSEL0, '\0', KEY_FSEL, 0});
+        schedule.push_back({0, true, '\0', KEY_DAC, 0});  // Enable the AD9834 internal DAC
+        for (size_t i = 1; i < ncodes; ++i) {
+            bool fsel = i % 2 == 1;
+            schedule.push_back({(i - 1) * dwell, fsel, '\0', KEY_STAGE, codes[i]});  // Staged as soon as the previous frequency is selected
+            schedule.push_back({i * dwell, fsel, '\0', KEY_FSEL, 0});
+        }
+        schedule.push_back({ncodes * dwell, false, '\0', KEY_DAC, 0});  // Disable the AD9834 internal DAC, which also marks the end of the sequence
+    }
+    return schedule;
+}
+
+// Loads a sequence of frequency codes from the given binary file, where each code is stored as a 32-bit little-endian unsigned integer
+// Codes can be obtained from frequencies (in KHz) using GF2Device::frequencyCode()
+std::vector<uint32_t> loadFrequencyCodes(const std::string &path, int &errcnt, std::string &errstr)
+{
+    std::vector<uint32_t> codes;
+    int preverrcnt = errcnt;
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file) {
+        ++errcnt;
+        errstr += "Could not open " + path + ".\n";
+    } else {
+        unsigned char bytes[4];
+        while (file.read(reinterpret_cast<char *>(bytes), sizeof(bytes))) {
+            uint32_t code = static_cast<uint32_t>(bytes[3] << 24 | bytes[2] << 16 | bytes[1] << 8 | bytes[0]);
+            if (code > GF2Device::FREQUENCY_CODE_MAX) {
+                ++errcnt;
+                errstr += "Frequency code out of range in " + path + ".\n";
+                codes.clear();
+                break;
+            }
+            codes.push_back(code);
+        }
+        if (errcnt == preverrcnt && file.gcount() != 0) {  // A partial code was read at the end of the file
+            ++errcnt;
+            errstr += "Size of " + path + " is not a multiple of four bytes.\n";
+            codes.clear();
+        } else if (errcnt == preverrcnt && codes.empty()) {
+            ++errcnt;
+            errstr += path + " contains no frequency codes.\n";
+        }
+    }
+    return codes;
+}
@@ -0,0 +1,527 @@
+/* Keyer class - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include "keyer.h"
+
+// Definitions
+const size_t LATENCY_PROBES = 15;           // Number of probes of each kind issued by calibrateLatency()
+const size_t SPEED_PROBES = 200;            // Number of probes of each kind issued by measureSpeedLimit()
+const size_t STREAM_TIMELINE_SIZE = 65536;  // Number of transitions kept while streaming
+
+// Counters of the probes submitted by measureSpeedLimit() that completed, and of those that failed
+struct ProbeCounter {
+    std::atomic<size_t> completed;
+    std::atomic<size_t> failed;
+};
+
+// Callback used by measureSpeedLimit(), which updates the given probe counter
+static void countProbe(const CP2130::TransferResult &result, void *userData)
+{
+    ProbeCounter *counter = static_cast<ProbeCounter *>(userData);
+    if (result.status != LIBUSB_TRANSFER_COMPLETED) {
+        counter->failed.fetch_add(1, std::memory_order_relaxed);
+    }
+    counter->completed.fetch_add(1, std::memory_order_release);
+}
+
+// Prints a summary of the timing report (values are displayed in microseconds)
+void Keyer::TimingReport::print(std::ostream &stream) const
+{
+    stream << "Timing report:\n"
+           << "  Transitions: " << transitions << "\n"
+           << "  Mean transition error: " << (transitions == 0 ? 0 : transitionErr / static_cast<int64_t>(transitions)) / 1000 << "us\n"
+           << "  Maximum transition error: " << transitionMax / 1000 << "us\n"
+           << "  Overruns: " << overruns << "\n"
+           << "  Elements: " << elements << "\n"
+           << "  Mean element length error: " << (elements == 0 ? 0 : elementErr / static_cast<int64_t>(elements)) / 1000 << "us\n"
+           << "  Maximum element length error: " << elementMax / 1000 << "us\n"
+           << "  Final drift: " << drift / 1000 << "us\n"
+           << "  Mean wakeup error: " << (transitions == 0 ? 0 : wakeupErr / static_cast<int64_t>(transitions)) / 1000 << "us\n"
+           << "  Maximum wakeup error: " << wakeupMax / 1000 << "us\n"
+           << "  Spin margin: " << spinMargin / 1000 << "us\n"
+           << "  DAC enable lead: " << enableLead / 1000 << "us\n"
+           << "  DAC disable lead: " << disableLead / 1000 << "us\n"
+           << "  FSEL lead: " << fselLead / 1000 << "us\n"
+           << "  PSEL lead: " << pselLead / 1000 << "us\n"
+           << "  Scheduling: " << (fifo ? "SCHED_FIFO" : "normal") << (locked ? ", memory locked" : "") << (pinned ? ", pinned to CPU" : "") << "\n";
+}
+
+// Prints the measured speed limit (latencies are displayed in microseconds)
+void Keyer::SpeedLimit::print(std::ostream &stream) const
+{
+    stream << "Speed limit:\n"
+           << "  Median transfer latency: " << latencyMedian / 1000 << "us\n"
+           << "  99th percentile transfer latency: " << latencyP99 / 1000 << "us\n"
+           << "  Service time: " << serviceTime / 1000 << "us\n"
+           << "  Maximum sustainable speed: ";
+    if (wpm > 0) {
+        stream << static_cast<int>(wpm) << " WPM\n";
+    } else {
+        stream << "unlimited\n";
+    }
+}
+
+// Private procedure used to account for the given transition once its transfer has completed, updating the timing report accordingly
+void Keyer::complete(const Transition &transition, int &errcnt, std::string &errstr)
+{
+    int64_t error = transition.completion - transition.ideal;
+    int64_t wakeup = transition.issue - transition.target;
+    ++report_.transitions;
+    report_.transitionErr += error;
+    if (error > report_.transitionMax) {
+        report_.transitionMax = error;
+    }
+    report_.wakeupErr += wakeup;
+    if (wakeup > report_.wakeupMax) {
+        report_.wakeupMax = wakeup;
+    }
+    if (transition.ideal < lastCompletion_) {  // The previous transition was still in progress when this one was due
+        ++report_.overruns;
+    }
+    lastCompletion_ = transition.completion;
+    if (traceEnabled_) {
+        timeline_.record({transition.action, transition.value, transition.ideal - origin_, transition.issue - origin_, transition.completion - origin_});
+    }
+    if (latencyCompensation_ && errcnt == 0) {  // The latency of each transfer, from its issue to its completion, updates the corresponding rolling median
+        int64_t latency = transition.completion - transition.issue;
+        if (transition.action == KEY_FSEL) {
+            fselLatency_.push(latency);
+        } else if (transition.action == KEY_PSEL) {
+            pselLatency_.push(latency);
+        } else if (transition.value) {
+            enableLatency_.push(latency);
+        } else {
+            disableLatency_.push(latency);
+        }
+    }
+    if (transition.action == KEY_DAC) {
+        if (transition.value) {  // Start of a keyed element
+            onIdeal_ = transition.ideal;
+            onActual_ = transition.completion;
+        } else {  // End of a keyed element
+            int64_t elementError = (transition.completion - onActual_) - (transition.ideal - onIdeal_);
+            elementError = elementError < 0 ? -elementError : elementError;
+            ++report_.elements;
+            report_.elementErr += elementError;
+            if (elementError > report_.elementMax) {
+                report_.elementMax = elementError;
+            }
+            if (meter_ != nullptr) {  // The counter is read while the DAC is disabled, before the next element starts
+                meter_->measure(transition.ideal - onIdeal_, transition.completion - onActual_, errcnt, errstr);
+            }
+        }
+    }
+    report_.drift = error;
+}
+
+// Private procedure used to fire the given event at the given absolute time of the clock (in nanoseconds), updating the timing report accordingly
+// In pipelined mode, DAC transfers are submitted without waiting for them to complete, and are accounted for once they do
+void Keyer::fire(const KeyEvent &event, int64_t ideal, int &errcnt, std::string &errstr)
+{
+    int64_t target = ideal;  // Errors are always reported against the ideal deadline, regardless of any corrections
+    if (latencyCompensation_ && event.action == KEY_FSEL) {  // Selections are issued early as well, so that RTTY and MFSK tone changes complete at their ideal deadlines
+        report_.fselLead = fselLatency_.median();
+        target -= report_.fselLead;
+    } else if (latencyCompensation_ && event.action == KEY_PSEL) {  // Likewise for PSK31 phase reversals
+        report_.pselLead = pselLatency_.median();
+        target -= report_.pselLead;
+    } else if (event.action == KEY_DAC && event.value != dacState_) {
+        if (latencyCompensation_) {  // DAC transfers are issued early by their typical latency, so that they complete at the ideal deadline
+            if (event.value) {
+                report_.enableLead = enableLatency_.median();
+                target -= report_.enableLead;
+            } else {
+                report_.disableLead = disableLatency_.median();
+                target -= report_.disableLead;
+            }
+        }
+        if (meter_ != nullptr && !event.value) {  // The end of each element is also corrected according to the lengths measured so far
+            target += meter_->compensation();
+        }
+    }
+    if (spinMargin_ > 0) {  // Sleep until shortly before the deadline, and spin for the rest, so that the wakeup latency of the scheduler is avoided
+        clock_.sleepUntil(target - spinMargin_);
+        clock_.spinUntil(target);
+    } else {
+        clock_.sleepUntil(target);
+    }
+    if (pipelined_) {
+        harvest(false, errcnt, errstr);  // Transitions that completed in the meantime are accounted for, without waiting for the others
+    }
+    int64_t issue = clock_.monotonicTime();  // Taken after harvesting, so that the latency of the transition does not include it
+    if (event.action == KEY_STAGE) {  // Staging is not time critical, as long as it completes before the register is selected
+        if (pipelined_) {
+            harvest(true, errcnt, errstr);  // The register to be written must no longer be selected by any selection still in flight
+        }
+        if (event.frame != nullptr) {
+            device_.writeWaveGenFrame(*event.frame, errcnt, errstr);
+        } else {
+            device_.setFrequencyCode(event.value, event.code, errcnt, errstr);
+        }
+        report_.drift = clock_.monotonicTime() - ideal;
+    } else if (event.action != KEY_DAC || event.value != dacState_) {  // DAC transfers are only issued for events that change its state, while selections are always issued
+        if (pipelined_) {
+            submit({event.action, event.value, ideal, target, issue, 0}, errcnt, errstr);
+        } else {
+            if (event.action == KEY_FSEL) {
+                device_.selectFrequency(event.value, errcnt, errstr);
+            } else if (event.action == KEY_PSEL) {
+                device_.selectPhase(event.value, errcnt, errstr);
+            } else {
+                device_.setDACEnabled(event.value, errcnt, errstr);
+            }
+            complete({event.action, event.value, ideal, target, issue, clock_.monotonicTime()}, errcnt, errstr);  // The transition is deemed to be complete when the transfer returns
+        }
+        if (event.action == KEY_DAC) {
+            dacState_ = event.value;
+        }
+    } else {
+        report_.drift = issue - ideal;
+    }
+}
+
+// Private procedure used to account for the pipelined transitions that have completed, in the order they were submitted
+// If "wait" is true, this only returns once all transitions have completed, which must be done before the end of each run
+void Keyer::harvest(bool wait, int &errcnt, std::string &errstr)
+{
+    while (pipelineTail_ != pipelineHead_) {
+        PendingTransition &pending = pipeline_[pipelineTail_ % PIPELINE_DEPTH];
+        if (!pending.done.load(std::memory_order_acquire)) {
+            if (!wait) {
+                break;
+            }
+            std::this_thread::yield();  // Transfers complete within a few milliseconds, so the wait is short
+        } else {
+            ++pipelineTail_;
+            if (pending.success) {
+                complete(pending.transition, errcnt, errstr);
+            } else {
+                ++errcnt;
+                errstr += "Failed asynchronous keying transfer.\n";
+                device_.refreshGPIOs(errcnt, errstr);  // The state of the pin is unknown
+            }
+        }
+    }
+}
+
+// Private procedure used to reset the timing report and the keying state, prior to each run, taking note of the real-time settings that were applied
+void Keyer::reset(const RealTimeScope &scope, int64_t origin)
+{
+    report_ = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, spinMargin_, 0, 0, 0, 0, scope.isFIFO(), scope.isLocked(), scope.isPinned()};
+    timeline_.clear();
+    origin_ = origin;
+    dacState_ = false;  // The DAC is assumed to be disabled at the start, as verified by the caller
+    lastCompletion_ = origin;
+    onIdeal_ = 0;
+    onActual_ = 0;
+}
+
+// Private procedure used to run the given schedule, relative to the given absolute start time of the clock (in nanoseconds)
+void Keyer::runFrom(const std::vector<KeyEvent> &schedule, int64_t start, int &errcnt, std::string &errstr)
+{
+    pthread_t eventThread;
+    RealTimeScope scope(realTime_, device_.eventThreadHandle(eventThread) ? &eventThread : nullptr);  // Applied to the calling thread for the duration of the run, and to the thread that completes its transfers
+    if (traceEnabled_) {
+        timeline_.reserve(schedule.size());  // So that no allocations take place while keying (the schedule holds at least as many events as there are transitions)
+    }
+    reset(scope, start);
+    size_t scheduleSize = schedule.size();
+    for (size_t i = 0; i < scheduleSize; ++i) {
+        fire(schedule[i], start + static_cast<int64_t>(schedule[i].deadline), errcnt, errstr);
+        if (schedule[i].character != '\0') {
+            std::cout << schedule[i].character << std::flush;  // Print character after the transition, so that terminal output does not delay it
+        }
+        if (errcnt != 0) {  // If one or more errors are detected
+            break;  // Break the cycle
+        }
+    }
+    harvest(true, errcnt, errstr);  // Pipelined transitions still in flight are waited for, even in case of error
+}
+
+// Private procedure used to submit the DAC, FSEL or PSEL transfer corresponding to the given transition, without waiting for it to complete (pipelined mode only)
+// If the pipeline is full, the oldest transition is waited for, which only happens if the device cannot keep up
+void Keyer::submit(const Transition &transition, int &errcnt, std::string &errstr)
+{
+    while (pipelineHead_ - pipelineTail_ == PIPELINE_DEPTH) {
+        harvest(false, errcnt, errstr);
+        std::this_thread::yield();
+    }
+    PendingTransition &pending = pipeline_[pipelineHead_ % PIPELINE_DEPTH];
+    pending.owner = this;
+    pending.transition = transition;
+    pending.success = false;
+    pending.done.store(false, std::memory_order_relaxed);
+    ++pipelineHead_;
+    if (transition.action == KEY_FSEL) {
+        device_.submitFrequencySelection(transition.value, completeTransition, &pending, errcnt, errstr);
+    } else if (transition.action == KEY_PSEL) {
+        device_.submitPhaseSelection(transition.value, completeTransition, &pending, errcnt, errstr);
+    } else {
+        device_.submitDACEnabled(transition.value, completeTransition, &pending, errcnt, errstr);
+    }
+}
+
+// Private callback invoked once a pipelined transfer completes, usually from the event handling thread, which timestamps the completion
+void Keyer::completeTransition(const CP2130::TransferResult &result, void *userData)
+{
+    PendingTransition *pending = static_cast<PendingTransition *>(userData);
+    pending->transition.completion = pending->owner->clock_.monotonicTime();
+    pending->success = result.status == LIBUSB_TRANSFER_COMPLETED;
+    pending->done.store(true, std::memory_order_release);  // Publishes the completion time and the outcome
+}
+
+// The keyer takes its time from the clock of the given device, so that a simulated device paired with a virtual clock is keyed in virtual time
+Keyer::Keyer(GF2Device &device) :
+    device_(device),
+    clock_(device.clock()),
+    meter_(nullptr),
+    report_({0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, false, false}),
+    realTime_({0, -1, false}),
+    pipelineHead_(0),
+    pipelineTail_(0),
+    dacState_(false),
+    latencyCompensation_(false),
+    pipelined_(false),
+    traceEnabled_(false),
+    lastCompletion_(0),
+    onIdeal_(0),
+    onActual_(0),
+    origin_(0),
+    spinMargin_(0)
+{
+    for (size_t i = 0; i < PIPELINE_DEPTH; ++i) {
+        pipeline_[i].done.store(true, std::memory_order_relaxed);
+    }
+}
+
+// Returns true if DAC transfers are issued early to compensate for their latency
+bool Keyer::isLatencyCompensationEnabled() const
+{
+    return latencyCompensation_;
+}
+
+// Returns true if DAC transfers are pipelined
+bool Keyer::isPipelined() const
+{
+    return pipelined_;
+}
+
+// Returns true if transitions are being traced
+bool Keyer::isTraceEnabled() const
+{
+    return traceEnabled_;
+}
+
+// Returns the timing report relative to the last run
+const Keyer::TimingReport &Keyer::report() const
+{
+    return report_;
+}
+
+// Returns the timeline relative to the last run, containing one entry per transition (empty if tracing is disabled)
+const Timeline &Keyer::timeline() const
+{
+    return timeline_;
+}
+
+// Prints the timing trace, one transition per line (deadlines and errors are displayed in microseconds)
+void Keyer::printTrace(std::ostream &stream) const
+{
+    timeline_.print(stream);
+}
+
+// Measures the latencies of DAC enable and disable transfers, as well as those of FSEL and PSEL transfers, by issuing probes that change no pins, and seeds the rolling medians with them
+// Only probes that succeed are taken into account, and this should be called before running a schedule with latency compensation enabled, since the first transitions would otherwise be issued without any lead
+void Keyer::calibrateLatency(int &errcnt, std::string &errstr)
+{
+    enableLatency_.clear();
+    disableLatency_.clear();
+    fselLatency_.clear();
+    pselLatency_.clear();
+    int preverrcnt = errcnt;
+    for (size_t i = 0; i < LATENCY_PROBES && errcnt == preverrcnt; ++i) {
+        int64_t issue = clock_.monotonicTime();
+        device_.probeDACEnabled(true, errcnt, errstr);
+        int64_t completion = clock_.monotonicTime();
+        if (errcnt == preverrcnt) {
+            enableLatency_.push(completion - issue);
+            issue = completion;
+            device_.probeDACEnabled(false, errcnt, errstr);
+            completion = clock_.monotonicTime();
+        }
+        if (errcnt == preverrcnt) {
+            disableLatency_.push(completion - issue);
+            issue = completion;
+            device_.probeFrequencySelection(i % 2 == 1, errcnt, errstr);  // Alternates between both values, as keying would
+            completion = clock_.monotonicTime();
+        }
+        if (errcnt == preverrcnt) {
+            fselLatency_.push(completion - issue);
+            issue = completion;
+            device_.probePhaseSelection(i % 2 == 1, errcnt, errstr);
+            completion = clock_.monotonicTime();
+        }
+        if (errcnt == preverrcnt) {
+            pselLatency_.push(completion - issue);
+        }
+    }
+}
+
+// Measures the highest speed at which the device can be keyed in pipelined mode, by issuing probes that change no pins
+// Probes are first issued one at a time, so as to measure the latency of a single transfer, and then queued back to back, so as to measure the time each one takes when pipelined
+// The speed is limited by the shortest dot that is longer than both the service time and ten times the jitter (the 99th percentile latency minus the median latency)
+Keyer::SpeedLimit Keyer::measureSpeedLimit(int &errcnt, std::string &errstr)
+{
+    SpeedLimit limit = {0, 0, 0, 0};
+    std::vector<int64_t> latencies;
+    latencies.reserve(SPEED_PROBES);
+    int preverrcnt = errcnt;
+    for (size_t i = 0; i < SPEED_PROBES && errcnt == preverrcnt; ++i) {
+        int64_t issue = clock_.monotonicTime();
+        device_.probeDACEnabled(i % 2 == 0, errcnt, errstr);
+        latencies.push_back(clock_.monotonicTime() - issue);
+    }
+    if (errcnt == preverrcnt) {
+        ProbeCounter counter;
+        counter.completed.store(0);
+        counter.failed.store(0);
+        int64_t start = clock_.monotonicTime();
+        for (size_t i = 0; i < SPEED_PROBES; ++i) {
+            while (i - counter.completed.load(std::memory_order_acquire) >= PIPELINE_DEPTH) {  // No more transfers are queued than while keying
+                std::this_thread::yield();
+            }
+            device_.submitDACProbe(i % 2 == 0, countProbe, &counter, errcnt, errstr);
+        }
+        while (counter.completed.load(std::memory_order_acquire) < SPEED_PROBES) {  // The counter must not go out of scope while probes are in flight
+            std::this_thread::yield();
+        }
+        if (counter.failed.load() > 0) {
+            ++errcnt;
+            errstr += "Failed asynchronous DAC transfer.\n";
+        } else {
+            std::sort(latencies.begin(), latencies.end());
+            limit.latencyMedian = latencies[SPEED_PROBES / 2];
+            limit.latencyP99 = latencies[99 * SPEED_PROBES / 100];
+            limit.serviceTime = (clock_.monotonicTime() - start) / static_cast<int64_t>(SPEED_PROBES);
+            int64_t dot = std::max(limit.serviceTime, 10 * (limit.latencyP99 - limit.latencyMedian));
+            limit.wpm = dot > 0 ? 1200000000.0 / static_cast<double>(dot) : 0;  // A dot lasts 1.2s divided by the speed in WPM
+        }
+    }
+    return limit;
+}
+
+// Runs the given schedule, firing each event at its absolute deadline
+// Since deadlines are absolute, the latency of each transfer delays only the corresponding transition, and is never carried over to the following ones
+void Keyer::run(const std::vector<KeyEvent> &schedule, int &errcnt, std::string &errstr)
+{
+    runFrom(schedule, clock_.monotonicTime(), errcnt, errstr);
+}
+
+// Runs the given schedule, as above, but starting at the given UTC time (in nanoseconds since the epoch)
+// The start time is converted to the monotonic time of the clock once, which is slewed along with the system clock, so that long schedules stay aligned to UTC
+void Keyer::run(const std::vector<KeyEvent> &schedule, int64_t utcStart, int &errcnt, std::string &errstr)
+{
+    runFrom(schedule, clock_.monotonicTime() + (utcStart - clock_.utcTime()), errcnt, errstr);
+}
+
+// Runs events as they are taken from the given ring buffer, until the producer flags that it has finished and the ring buffer is empty
+// Characters to be displayed are passed to the given echo ring buffer, so that the keyer never waits for terminal output (they are dropped if the consumer falls behind)
+// If the ring buffer runs dry (i.e., the input stalls), the schedule is shifted so that the next event fires as soon as it becomes available
+void Keyer::run(KeyEventRing &events, const std::atomic<bool> &finished, EchoRing &echo, int &errcnt, std::string &errstr)
+{
+    pthread_t eventThread;
+    RealTimeScope scope(realTime_, device_.eventThreadHandle(eventThread) ? &eventThread : nullptr);  // Applied to the calling thread (i.e., the keying thread) for the duration of the run, and to the thread that completes its transfers
+    if (traceEnabled_ && timeline_.capacity() < STREAM_TIMELINE_SIZE) {
+        timeline_.reserve(STREAM_TIMELINE_SIZE);  // The number of transitions is not known beforehand, so only the most recent ones are kept
+    }
+    int64_t start = clock_.monotonicTime();
+    reset(scope, start);
+    bool starved = false;
+    while (true) {
+        KeyEvent event;
+        if (events.pop(event)) {
+            int64_t ideal = start + static_cast<int64_t>(event.deadline);
+            if (starved) {
+                int64_t now = clock_.monotonicTime();
+                if (ideal < now) {  // The deadline was missed while waiting for input, so the remaining schedule is shifted accordingly
+                    start += now - ideal;
+                    ideal = now;
+                }
+                starved = false;
+            }
+            fire(event, ideal, errcnt, errstr);
+            if (event.character != '\0') {
+                echo.push(event.character);
+            }
+            if (errcnt != 0) {  // If one or more errors are detected
+                break;  // Break the cycle
+            }
+        } else if (finished.load(std::memory_order_acquire) && events.empty()) {  // The ring buffer is checked again, since the producer may have pushed more events before flagging
+            break;
+        } else {
+            starved = true;
+            clock_.sleepFor(1000000);  // Wait 1ms for more events
+        }
+    }
+    harvest(true, errcnt, errstr);
+}
+
+// Enables or disables latency compensation, whereby each DAC transfer is issued early by the rolling median of the latencies of previous transfers of the same kind (disabled by default)
+// Enable and disable transfers are tracked separately, since any difference between their latencies would otherwise lengthen or shorten every element
+void Keyer::setLatencyCompensation(bool value)
+{
+    latencyCompensation_ = value;
+}
+
+// Sets the event counter meter used to measure each element, which must have been started beforehand (nullptr disables measurements)
+void Keyer::setMeter(EventMeter *meter)
+{
+    meter_ = meter;
+}
+
+// Enables or disables pipelined mode, whereby DAC, FSEL and PSEL transfers are submitted asynchronously, and the keyer goes on to the next event without waiting for them to complete (disabled by default)
+// Up to eight transfers can be in flight, and each one is accounted for once it completes, so that the timing report reflects when transitions actually took place
+void Keyer::setPipelined(bool value)
+{
+    pipelined_ = value;
+}
+
+// Sets the real-time settings to be applied to the keying thread during each run (by default, none are applied)
+void Keyer::setRealTime(const RealTimeSettings &settings)
+{
+    realTime_ = settings;
+}
+
+// Sets the margin before each deadline during which the keyer spins instead of sleeping, in nanoseconds (zero, by default, disables spinning)
+// The margin should exceed the typical wakeup latency of the system, but keep in mind that the CPU is kept busy for its duration
+void Keyer::setSpinMargin(int64_t margin)
+{
+    spinMargin_ = margin < 0 ? 0 : margin;
+}
+
+// Enables or disables the tracing of transitions, which applies from the next run onwards
+void Keyer::setTraceEnabled(bool value)
+{
+    traceEnabled_ = value;
+}
@@ -0,0 +1,158 @@
+/* Keyer class - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef KEYER_H
+#define KEYER_H
+
+// Includes
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "clock.h"
+#include "eventmeter.h"
+#include "gf2device.h"
+#include "realtime.h"
+#include "ringbuffer.h"
+#include "rollingmedian.h"
+#include "timeline.h"
+
+// Actions applicable to KeyEvent
+const uint8_t KEY_DAC = 0;    // Enable or disable the DAC internal to the AD9834 (default action)
+const uint8_t KEY_FSEL = 1;   // Select the active frequency register
+const uint8_t KEY_PSEL = 2;   // Select the active phase register
+const uint8_t KEY_STAGE = 3;  // Write a frequency code to a frequency register (usually the inactive one, ahead of a KEY_FSEL event)
+
+struct KeyEvent {
+    uint64_t deadline;  // Deadline in nanoseconds, relative to the start of the schedule
+    bool value;         // DAC state to be set at the deadline (true for enabled), or register to be selected or written to
+    char character;     // Character to be displayed once the event fires, or '\0' if none
+    uint8_t action;     // Action to be taken at the deadline (KEY_DAC, unless specified otherwise)
+    uint32_t code;      // Frequency code to be written (KEY_STAGE only)
+    const std::vector<uint8_t> *frame;  // Prebuilt frame to be written instead of "code", or nullptr if none (KEY_STAGE only)
+};
+
+typedef RingBuffer<char, 256> EchoRing;           // Ring buffer of characters to be displayed, used while streaming
+typedef RingBuffer<KeyEvent, 1024> KeyEventRing;  // Ring buffer of events, used while streaming
+
+class Keyer
+{
+public:
+    struct TimingReport {
+        size_t transitions;      // Number of transitions (DAC, FSEL and PSEL)
+        int64_t transitionErr;   // Sum of the transition errors (in ns)
+        int64_t transitionMax;   // Maximum transition error (in ns)
+        size_t overruns;         // Number of transitions that were due before the previous one had completed, meaning that the device could not keep up
+        size_t elements;         // Number of keyed elements
+        int64_t elementErr;      // Sum of the absolute element length errors (in ns)
+        int64_t elementMax;      // Maximum absolute element length error (in ns)
+        int64_t drift;           // Deviation of the last event from its deadline (in ns)
+        int64_t wakeupErr;       // Sum of the wakeup errors, which are the delays between deadlines and the start of the corresponding transfers (in ns)
+        int64_t wakeupMax;       // Maximum wakeup error (in ns)
+        int64_t spinMargin;      // Margin before each deadline during which the keyer spins instead of sleeping (in ns)
+        int64_t enableLead;      // Lead with which the last DAC enable transfer was issued, if latency compensation is enabled (in ns)
+        int64_t disableLead;     // Lead with which the last DAC disable transfer was issued, if latency compensation is enabled (in ns)
+        int64_t fselLead;        // Lead with which the last FSEL transfer was issued, if latency compensation is enabled (in ns)
+        int64_t pselLead;        // Lead with which the last PSEL transfer was issued, if latency compensation is enabled (in ns)
+        bool fifo;               // True if the keying thread ran under SCHED_FIFO
+        bool locked;             // True if memory was locked
+        bool pinned;             // True if the keying thread was pinned to a CPU
+
+        void print(std::ostream &stream) const;
+    };
+
+    struct SpeedLimit {
+        int64_t latencyMedian;  // Median latency of a single DAC transfer (in ns)
+        int64_t latencyP99;     // 99th percentile latency of a single DAC transfer (in ns)
+        int64_t serviceTime;    // Mean time taken by each DAC transfer, when transfers are queued back to back (in ns)
+        double wpm;             // Highest speed, in words per minute (PARIS standard), at which DAC transfers do not pile up, and their jitter stays within a tenth of a dot, or zero if transfers take no time
+
+        void print(std::ostream &stream) const;
+    };
+
+private:
+    struct Transition {
+        uint8_t action;      // Action taken (KEY_DAC, KEY_FSEL or KEY_PSEL)
+        bool value;          // Value set
+        int64_t ideal;       // Ideal deadline (in ns, absolute time of the clock)
+        int64_t target;      // Deadline after any corrections
+        int64_t issue;       // Time at which the transfer was issued
+        int64_t completion;  // Time at which the transfer completed
+    };
+
+    // Transition submitted asynchronously, whose completion is awaited without blocking the keyer (pipelined mode only)
+    struct PendingTransition {
+        Keyer *owner;
+        Transition transition;
+        std::atomic<bool> done;  // Set from the event handling thread once the transfer completes, after "transition.completion" and "success"
+        bool success;
+    };
+
+    static const size_t PIPELINE_DEPTH = 8;   // Maximum number of transfers in flight (pipelined mode only)
+    static const size_t LATENCY_WINDOW = 31;  // Number of transfer latencies over which each rolling median is taken
+
+    GF2Device &device_;
+    Clock &clock_;
+    EventMeter *meter_;  // Meter used to measure each element and correct the end of subsequent ones, or nullptr if none
+    TimingReport report_;
+    Timeline timeline_;
+    RealTimeSettings realTime_;
+    RollingMedian<LATENCY_WINDOW> enableLatency_, disableLatency_;  // Latencies of the last DAC enable and disable transfers (in ns)
+    RollingMedian<LATENCY_WINDOW> fselLatency_, pselLatency_;       // Latencies of the last FSEL and PSEL transfers (in ns)
+    PendingTransition pipeline_[PIPELINE_DEPTH];
+    size_t pipelineHead_, pipelineTail_;  // Number of transitions submitted and harvested, respectively (pipelined mode only)
+    bool dacState_, latencyCompensation_, pipelined_, traceEnabled_;
+    int64_t lastCompletion_, onIdeal_, onActual_, origin_, spinMargin_;
+
+    void complete(const Transition &transition, int &errcnt, std::string &errstr);
+    void fire(const KeyEvent &event, int64_t ideal, int &errcnt, std::string &errstr);
+    void harvest(bool wait, int &errcnt, std::string &errstr);
+    void reset(const RealTimeScope &scope, int64_t origin);
+    void runFrom(const std::vector<KeyEvent> &schedule, int64_t start, int &errcnt, std::string &errstr);
+    void submit(const Transition &transition, int &errcnt, std::string &errstr);
+
+    static void completeTransition(const CP2130::TransferResult &result, void *userData);
+
+public:
+    explicit Keyer(GF2Device &device);
+
+    bool isLatencyCompensationEnabled() const;
+    bool isPipelined() const;
+    bool isTraceEnabled() const;
+    const TimingReport &report() const;
+    const Timeline &timeline() const;
+
+    void printTrace(std::ostream &stream) const;
+
+    void calibrateLatency(int &errcnt, std::string &errstr);
+    SpeedLimit measureSpeedLimit(int &errcnt, std::string &errstr);
+    void run(const std::vector<KeyEvent> &schedule, int &errcnt, std::string &errstr);
+    void run(const std::vector<KeyEvent> &schedule, int64_t utcStart, int &errcnt, std::string &errstr);
+    void run(KeyEventRing &events, const std::atomic<bool> &finished, EchoRing &echo, int &errcnt, std::string &errstr);
+    void setLatencyCompensation(bool value);
+    void setMeter(EventMeter *meter);
+    void setPipelined(bool value);
+    void setRealTime(const RealTimeSettings &settings);
+    void setSpinMargin(int64_t margin);
+    void setTraceEnabled(bool value);
+};
+
+#endif  // KEYER_H
@@ -0,0 +1,108 @@
+/* MFSK functions - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <cmath>
+#include <fstream>
+#include "mfsk.h"
+
+// Definitions
+const double CODES_PER_HZ = 268435456 / 80000000.0;  // Frequency codes per hertz, given the 28-bit resolution and the 80MHz clock of the AD9834 waveform generator
+
+// Compiles the given symbols into a schedule of timed events, using frames as returned by compileToneFrames()
+// The tone corresponding to the first symbol must already be set in FREQ0 and selected, so that the DAC can be enabled as soon as the schedule starts
+// Each new tone is written to the inactive frequency register (FREQ0 or FREQ1) as soon as the previous one is selected, and selected at the start of its symbol by toggling FSEL alone
+// Symbol boundaries are calculated from their index, so that rounding errors never accumulate
+std::vector<KeyEvent> compileMFSK(const MFSKMode &mode, const std::vector<uint8_t> &symbols, const std::vector<std::vector<uint8_t>> &frames)
+{
+    std::vector<KeyEvent> schedule;
+    size_t nsymbols = symbols.size();
+    if (nsymbols > 0) {
+        bool fsel = GF2Device::FSEL0;
+        uint8_t tone = symbols[0];
+        uint64_t selected = 0;  // Deadline of the last selection
+        schedule.push_back({0, true, '\0', KEY_DAC, 0, nullptr});  // Enable the AD9834 internal DAC
+        for (size_t i = 1; i < nsymbols; ++i) {
+            if (symbols[i] != tone) {  // Repeated tones require no transfers
+                fsel = !fsel;
+                tone = symbols[i];
+                uint64_t deadline = static_cast<uint64_t>(i * mode.symbol + 0.5);
+                schedule.push_back({selected, fsel, '\0', KEY_STAGE, 0, &frames[2 * tone + fsel]});
+                schedule.push_back({deadline, fsel, '\0', KEY_FSEL, 0, nullptr});
+                selected = deadline;
+            }
+        }
+        schedule.push_back({static_cast<uint64_t>(nsymbols * mode.symbol + 0.5), false, '\0', KEY_DAC, 0, nullptr});  // Disable the AD9834 internal DAC, which also marks the end of the transmission
+    }
+    return schedule;
+}
+
+// Builds the frames that set each tone of the given mode, for both frequency registers, the lowest tone being set to the given frequency (in KHz)
+// The frame that sets tone n on FREQ0 is at index 2n, and the one that sets it on FREQ1 is at index 2n + 1
+// Codes are calculated in double precision, given that the spacing of some modes is only a few times the resolution of the AD9834
+std::vector<std::vector<uint8_t>> compileToneFrames(const MFSKMode &mode, double frequency)
+{
+    std::vector<std::vector<uint8_t>> frames;
+    frames.reserve(2 * mode.tones);
+    for (unsigned int i = 0; i < mode.tones; ++i) {
+        uint32_t code = static_cast<uint32_t>(std::llround((1000 * frequency + i * mode.spacing) * CODES_PER_HZ));
+        frames.push_back(GF2Device::frequencyFrame(GF2Device::FSEL0, code));
+        frames.push_back(GF2Device::frequencyFrame(GF2Device::FSEL1, code));
+    }
+    return frames;
+}
+
+// Loads the symbols of a transmission in the given mode from the given text file, where each symbol is given by a single digit
+// Any whitespace and commas are ignored, so that the output of most encoders can be used directly
+std::vector<uint8_t> loadSymbols(const MFSKMode &mode, const std::string &path, int &errcnt, std::string &errstr)
+{
+    std::vector<uint8_t> symbols;
+    int preverrcnt = errcnt;
+    std::ifstream file(path.c_str());
+    if (!file) {
+        ++errcnt;
+        errstr += "Could not open " + path + ".\n";
+    } else {
+        char character;
+        while (file.get(character)) {
+            if (character >= '0' && static_cast<unsigned int>(character - '0') < mode.tones) {
+                symbols.push_back(static_cast<uint8_t>(character - '0'));
+            } else if (character != ' ' && character != ',' && character != '\t' && character != '\n' && character != '\r') {
+                ++errcnt;
+                errstr += path + " contains an invalid " + mode.name + " symbol.\n";
+                symbols.clear();
+                break;
+            }
+        }
+        if (errcnt == preverrcnt && symbols.size() != mode.symbols) {
+            ++errcnt;
+            errstr += path + " must contain exactly " + std::to_string(mode.symbols) + " " + mode.name + " symbols.\n";
+            symbols.clear();
+        }
+    }
+    return symbols;
+}
+
+// Returns the UTC time (in nanoseconds since the epoch) when the next transmission in the given mode should start, at least "lead" nanoseconds from the current time of the given clock
+int64_t nextSlot(const MFSKMode &mode, int64_t lead, const Clock &clock)
+{
+    int64_t earliest = clock.utcTime() + lead - mode.offset;
+    return (earliest / mode.slot + (earliest % mode.slot != 0 ? 1 : 0)) * mode.slot + mode.offset;
+}
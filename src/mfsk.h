@@ -0,0 +1,51 @@
+/* MFSK functions - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef MFSK_H
+#define MFSK_H
+
+// Includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "keyer.h"
+
+struct MFSKMode {
+    const char *name;      // Name of the mode
+    unsigned int tones;    // Number of tones
+    double spacing;        // Spacing between adjacent tones (in Hz)
+    double symbol;         // Symbol period (in ns)
+    size_t symbols;        // Number of symbols per transmission
+    int64_t slot;          // Period of the UTC-aligned slots where transmissions take place (in ns)
+    int64_t offset;        // Offset of the start of each transmission, relative to the start of its slot (in ns)
+};
+
+// Supported modes
+const MFSKMode MFSK_FT8 = {"FT8", 8, 6.25, 160000000.0, 79, 15000000000, 500000000};
+const MFSKMode MFSK_WSPR = {"WSPR", 4, 12000.0 / 8192, 8192 * 1000000000.0 / 12000, 162, 120000000000, 1000000000};
+
+// Function prototypes
+std::vector<KeyEvent> compileMFSK(const MFSKMode &mode, const std::vector<uint8_t> &symbols, const std::vector<std::vector<uint8_t>> &frames);
+std::vector<std::vector<uint8_t>> compileToneFrames(const MFSKMode &mode, double frequency);
+std::vector<uint8_t> loadSymbols(const MFSKMode &mode, const std::string &path, int &errcnt, std::string &errstr);
+int64_t nextSlot(const MFSKMode &mode, int64_t lead, const Clock &clock);
+
+#endif  // MFSK_H
@@ -0,0 +1,135 @@
+/* Morse code functions - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include "morsecode.h"
+
+// Packs a character code given as a string of dots and dashes into a 16-bit word, at compile time
+// The length is stored in the most significant byte, while the least significant byte holds the elements (bit n set for a dash, or cleared for a dot, n being the element index)
+static constexpr uint16_t morseCode(const char *elements, uint8_t length = 0, uint8_t pattern = 0)
+{
+    return *elements == '\0' ? static_cast<uint16_t>(length << 8 | pattern) : morseCode(elements + 1, static_cast<uint8_t>(length + 1), static_cast<uint8_t>(pattern | (*elements == '-') << length));
+}
+
+// Character codes, indexed by character (characters without a code correspond to a zero value)
+static constexpr uint16_t CHAR_CODES[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0x00-0x07
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0x08-0x0f
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0x10-0x17
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0x18-0x1f
+    0, morseCode("-.-.--"), morseCode(".-..-."), 0, morseCode("...-..-"), 0, morseCode(".-..."), morseCode(".----."),  // 0x20-0x27
+    morseCode("-.--."), morseCode("-.--.-"), 0, morseCode(".-.-."), morseCode("--..--"), morseCode("-....-"), morseCode(".-.-.-"), morseCode("-..-."),  // 0x28-0x2f
+    morseCode("-----"), morseCode(".----"), morseCode("..---"), morseCode("...--"), morseCode("....-"), morseCode("....."), morseCode("-...."), morseCode("--..."),  // 0x30-0x37
+    morseCode("---.."), morseCode("----."), morseCode("---..."), morseCode("-.-.-."), 0, morseCode("-...-"), 0, morseCode("..--.."),  // 0x38-0x3f
+    morseCode(".--.-."), morseCode(".-"), morseCode("-..."), morseCode("-.-."), morseCode("-.."), morseCode("."), morseCode("..-."), morseCode("--."),  // 0x40-0x47
+    morseCode("...."), morseCode(".."), morseCode(".---"), morseCode("-.-"), morseCode(".-.."), morseCode("--"), morseCode("-."), morseCode("---"),  // 0x48-0x4f
+    morseCode(".--."), morseCode("--.-"), morseCode(".-."), morseCode("..."), morseCode("-"), morseCode("..-"), morseCode("...-"), morseCode(".--"),  // 0x50-0x57
+    morseCode("-..-"), morseCode("-.--"), morseCode("--.."), 0, 0, 0, 0, morseCode("..--.-"),  // 0x58-0x5f
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0x60-0x67
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0x68-0x6f
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0x70-0x77
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0x78-0x7f
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0x80-0x87
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0x88-0x8f
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0x90-0x97
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0x98-0x9f
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0xa0-0xa7
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0xa8-0xaf
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0xb0-0xb7
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0xb8-0xbf
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0xc0-0xc7
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0xc8-0xcf
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0xd0-0xd7
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0xd8-0xdf
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0xe0-0xe7
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0xe8-0xef
+    0, 0, 0, 0, 0, 0, 0, 0,  // 0xf0-0xf7
+    0, 0, 0, 0, 0, 0, 0, 0   // 0xf8-0xff
+};
+
+// Appends the events that signal the given character code to the schedule, adding a trailing inter-character space (the time unit is given in nanoseconds)
+void compileCharCode(uint16_t code, char character, uint64_t tunit, uint64_t &time, std::vector<KeyEvent> &schedule)
+{
+    uint8_t length = static_cast<uint8_t>(code >> 8);
+    for (uint8_t i = 0; i < length; ++i) {
+        bool dash = (0x01 << i & code) != 0x0000;
+        schedule.push_back({time, true, i == 0 ? character : '\0'});  // Enable the AD9834 internal DAC (the character is displayed along with its first element)
+        time += dash ? 3 * tunit : tunit;  // Corresponds to a "dash" or to a "dot"
+        schedule.push_back({time, false, '\0'});  // Disable the AD9834 internal DAC
+        time += tunit;  // Corresponds to an intra-character space
+    }
+    time += 2 * tunit;  // Inter-character space
+}
+
+// Appends the events that signal the given character to the schedule, taking into account the character that precedes it ('\0' if none)
+// Returns and spaces are treated as word spaces, except if they follow another word space
+void compileCharacter(char character, char previous, uint64_t tunit, uint64_t &time, std::vector<KeyEvent> &schedule)
+{
+    if ((character == '\n' || character == ' ') && previous != '\0' && previous != '\n' && previous != ' ') {  // Returns treated as spaces. Extra spaces and returns are to be omitted!
+        schedule.push_back({time, false, ' '});
+        time += 4 * tunit;  // Word space
+    } else {
+        if (character >= 'a' && character <= 'z') {  // If lowercase
+            character -= 32;  // Convert to uppercase
+        }
+        uint16_t code = CHAR_CODES[static_cast<unsigned char>(character)];
+        if (code != 0) {  // If character exists
+            compileCharCode(code, character, tunit, time, schedule);
+        }
+    }
+}
+
+// Compiles the given message into a schedule of timed events (the time unit is given in nanoseconds)
+// The last event marks the end of the message, and does not change the state of the DAC
+std::vector<KeyEvent> compileMessage(const std::string &message, uint64_t tunit)
+{
+    std::vector<KeyEvent> schedule;
+    uint64_t time = 0;
+    size_t strLength = message.size();
+    schedule.reserve(8 * strLength + 1);  // Letters take up to four elements, of two events each, so that most messages are compiled without reallocating
+    for (size_t i = 0; i < strLength; ++i) {
+        compileCharacter(message[i], i == 0 ? '\0' : message[i - 1], tunit, time, schedule);
+    }
+    schedule.push_back({time, false, '\0'});  // End of message
+    return schedule;
+}
+
+// Compiles the given message into a schedule that repeats it the given number of times, each repetition starting "interval" nanoseconds after the previous one (the time unit is given in nanoseconds)
+// If the interval is shorter than the message, repetitions are separated by a word space instead, and a newline is displayed at the end of each repetition but the last
+std::vector<KeyEvent> compileRepeatedMessage(const std::string &message, uint64_t tunit, unsigned int repeat, uint64_t interval)
+{
+    std::vector<KeyEvent> single = compileMessage(message, tunit);
+    std::vector<KeyEvent> schedule;
+    schedule.reserve(repeat * single.size());
+    uint64_t offset = 0;
+    for (unsigned int i = 0; i < repeat; ++i) {
+        size_t singleSize = single.size();
+        for (size_t j = 0; j < singleSize; ++j) {
+            schedule.push_back(single[j]);
+            schedule.back().deadline += offset;
+        }
+        if (i + 1 < repeat) {
+            schedule.back().character = '\n';
+        }
+        uint64_t earliest = schedule.back().deadline + 4 * tunit;  // Adding to the inter-character space that ends the message, this makes a word space
+        offset = offset + interval > earliest ? offset + interval : earliest;
+    }
+    return schedule;
+}
@@ -0,0 +1,36 @@
+/* Morse code functions - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef MORSECODE_H
+#define MORSECODE_H
+
+// Includes
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "keyer.h"
+
+// Function prototypes
+void compileCharacter(char character, char previous, uint64_t tunit, uint64_t &time, std::vector<KeyEvent> &schedule);
+void compileCharCode(uint16_t code, char character, uint64_t tunit, uint64_t &time, std::vector<KeyEvent> &schedule);
+std::vector<KeyEvent> compileMessage(const std::string &message, uint64_t tunit);
+std::vector<KeyEvent> compileRepeatedMessage(const std::string &message, uint64_t tunit, unsigned int repeat, uint64_t interval);
+
+#endif  // MORSECODE_H
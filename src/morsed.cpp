@@ -0,0 +1,97 @@
+/* GF2 Morse daemon client functions - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "morsed.h"
+
+// Connects to the daemon listening on the given socket, returning the socket descriptor, or -1 if no daemon is running
+int connectDaemon(const std::string &socketPath)
+{
+    int fd = -1;
+    sockaddr_un addr;
+    if (socketPath.size() < sizeof(addr.sun_path)) {  // Paths that do not fit are never valid
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::strcpy(addr.sun_path, socketPath.c_str());
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {  // If the connection is refused, or if the socket does not exist
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    return fd;
+}
+
+// Reads from the given descriptor until the end of file, up to the given limit, returning false in case of failure
+bool readAll(int fd, std::string &data, size_t limit)
+{
+    bool success = true;
+    char buffer[4096];
+    ssize_t nread;
+    while ((nread = read(fd, buffer, sizeof(buffer))) != 0) {
+        if (nread < 0) {
+            if (errno != EINTR) {
+                success = false;
+                break;
+            }
+        } else if (data.size() + static_cast<size_t>(nread) > limit) {
+            success = false;
+            break;
+        } else {
+            data.append(buffer, static_cast<size_t>(nread));
+        }
+    }
+    return success;
+}
+
+// Submits the given message to the daemon, and waits for the reply, which is sent only after the message is signaled
+bool submitMessage(int fd, const std::string &message, std::string &reply)
+{
+    bool success = writeAll(fd, message) && shutdown(fd, SHUT_WR) == 0;  // Shutting down the write side of the socket marks the end of the message
+    if (success) {
+        success = readAll(fd, reply, 4096);
+    }
+    ::close(fd);
+    return success;
+}
+
+// Writes the given data to the given descriptor, returning false in case of failure
+bool writeAll(int fd, const std::string &data)
+{
+    bool success = true;
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t nwritten = write(fd, data.data() + written, data.size() - written);
+        if (nwritten < 0) {
+            if (errno != EINTR) {
+                success = false;
+                break;
+            }
+        } else {
+            written += static_cast<size_t>(nwritten);
+        }
+    }
+    return success;
+}
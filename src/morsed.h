@@ -0,0 +1,36 @@
+/* GF2 Morse daemon client functions - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef MORSED_H
+#define MORSED_H
+
+// Includes
+#include <string>
+
+// Definitions
+const std::string MORSED_SOCKET = "/tmp/gf2-morsed.socket";  // Default path of the socket where gf2-morsed accepts messages
+
+// Function prototypes
+int connectDaemon(const std::string &socketPath);
+bool readAll(int fd, std::string &data, size_t limit);
+bool submitMessage(int fd, const std::string &message, std::string &reply);
+bool writeAll(int fd, const std::string &data);
+
+#endif  // MORSED_H
@@ -0,0 +1,111 @@
+/* PSK31 functions - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include "psk31.h"
+
+// Definitions
+const int IDLE_SYMBOLS = 32;  // Number of symbols in the preamble (phase reversals) and in the postamble (steady carrier)
+
+// Packs a varicode given as a string of bits into a 16-bit word, at compile time
+// The length is stored in the most significant nibble, while the remaining bits hold the code (bit n set for a one, or cleared for a zero, n being the bit index)
+static constexpr uint16_t varicode(const char *bits, uint8_t length = 0, uint16_t pattern = 0)
+{
+    return *bits == '\0' ? static_cast<uint16_t>(length << 12 | pattern) : varicode(bits + 1, static_cast<uint8_t>(length + 1), static_cast<uint16_t>(pattern | (*bits == '1') << length));
+}
+
+// Varicodes, indexed by ASCII character (every code starts and ends with a one, and never contains two consecutive zeros)
+static constexpr uint16_t VARICODES[128] = {
+    varicode("1010101011"), varicode("1011011011"), varicode("1011101101"), varicode("1101110111"), varicode("1011101011"), varicode("1101011111"), varicode("1011101111"), varicode("1011111101"),  // 0x00-0x07
+    varicode("1011111111"), varicode("11101111"), varicode("11101"), varicode("1101101111"), varicode("1011011101"), varicode("11111"), varicode("1101110101"), varicode("1110101011"),  // 0x08-0x0f
+    varicode("1011110111"), varicode("1011110101"), varicode("1110101101"), varicode("1110101111"), varicode("1101011011"), varicode("1101101011"), varicode("1101101101"), varicode("1101010111"),  // 0x10-0x17
+    varicode("1101111011"), varicode("1101111101"), varicode("1110110111"), varicode("1101010101"), varicode("1101011101"), varicode("1110111011"), varicode("1011111011"), varicode("1101111111"),  // 0x18-0x1f
+    varicode("1"), varicode("111111111"), varicode("101011111"), varicode("111110101"), varicode("111011011"), varicode("1011010101"), varicode("1010111011"), varicode("101111111"),  // 0x20-0x27
+    varicode("11111011"), varicode("11110111"), varicode("101101111"), varicode("111011111"), varicode("1110101"), varicode("110101"), varicode("1010111"), varicode("110101111"),  // 0x28-0x2f
+    varicode("10110111"), varicode("10111101"), varicode("11101101"), varicode("11111111"), varicode("101110111"), varicode("101011011"), varicode("101101011"), varicode("110101101"),  // 0x30-0x37
+    varicode("110101011"), varicode("110110111"), varicode("11110101"), varicode("110111101"), varicode("111101101"), varicode("1010101"), varicode("111010111"), varicode("1010101111"),  // 0x38-0x3f
+    varicode("1010111101"), varicode("1111101"), varicode("11101011"), varicode("10101101"), varicode("10110101"), varicode("1110111"), varicode("11011011"), varicode("11111101"),  // 0x40-0x47
+    varicode("101010101"), varicode("1111111"), varicode("111111101"), varicode("101111101"), varicode("11010111"), varicode("10111011"), varicode("11011101"), varicode("10101011"),  // 0x48-0x4f
+    varicode("11010101"), varicode("111011101"), varicode("10101111"), varicode("1101111"), varicode("1101101"), varicode("101010111"), varicode("110110101"), varicode("101011101"),  // 0x50-0x57
+    varicode("101110101"), varicode("101111011"), varicode("1010101101"), varicode("111110111"), varicode("111101111"), varicode("111111011"), varicode("1010111111"), varicode("101101101"),  // 0x58-0x5f
+    varicode("1011011111"), varicode("1011"), varicode("1011111"), varicode("101111"), varicode("101101"), varicode("11"), varicode("111101"), varicode("1011011"),  // 0x60-0x67
+    varicode("101011"), varicode("1101"), varicode("111101011"), varicode("10111111"), varicode("11011"), varicode("111011"), varicode("1111"), varicode("111"),  // 0x68-0x6f
+    varicode("111111"), varicode("110111111"), varicode("10101"), varicode("10111"), varicode("101"), varicode("110111"), varicode("1111011"), varicode("1101011"),  // 0x70-0x77
+    varicode("11011111"), varicode("1011101"), varicode("111010101"), varicode("1010110111"), varicode("110111011"), varicode("1010110101"), varicode("1011010111"), varicode("1110110101")   // 0x78-0x7f
+};
+
+// Appends the events that signal the given bit to the schedule, occupying a single symbol
+// A zero is signaled by a phase reversal (toggling PSEL) at the start of the symbol, while a one leaves the phase unchanged
+static void compileBit(bool bit, bool &psel, uint64_t &time, std::vector<KeyEvent> &schedule)
+{
+    if (!bit) {
+        psel = !psel;
+        schedule.push_back({time, psel, '\0', KEY_PSEL, 0});
+    }
+    time += PSK31_SYMBOL;
+}
+
+// Appends the events that signal the given varicode to the schedule, followed by the two zeros that separate characters
+static void compileVaricode(uint16_t code, char character, bool &psel, uint64_t &time, std::vector<KeyEvent> &schedule)
+{
+    uint8_t length = static_cast<uint8_t>(code >> 12);
+    schedule.push_back({time, true, character});  // Does not change the state of the DAC, but displays the character along with its first bit (which is always a one)
+    for (uint8_t i = 0; i < length; ++i) {
+        compileBit((0x0001 << i & code) != 0x0000, psel, time, schedule);
+    }
+    compileBit(false, psel, time, schedule);
+    compileBit(false, psel, time, schedule);
+}
+
+// Appends the events that signal the given character to the schedule, given the currently selected phase register
+// Returns are sent as CR followed by LF, and characters outside the ASCII range are ignored
+void compilePSK31Character(char character, bool &psel, uint64_t &time, std::vector<KeyEvent> &schedule)
+{
+    unsigned char index = static_cast<unsigned char>(character);
+    if (character == '\n') {
+        compileVaricode(VARICODES['\r'], '\0', psel, time, schedule);
+        compileVaricode(VARICODES['\n'], '\n', psel, time, schedule);
+    } else if (index < 128) {
+        compileVaricode(VARICODES[index], character, psel, time, schedule);
+    }
+}
+
+// Compiles the given message into a schedule of timed events, to be signaled in PSK31 (BPSK at 31.25 baud)
+// PHASE0 and PHASE1 must be set 180 degrees apart beforehand, so that toggling PSEL reverses the phase of the carrier
+// The message is preceded by a series of phase reversals, so that receivers can synchronize, and followed by a steady carrier
+std::vector<KeyEvent> compilePSK31Message(const std::string &message)
+{
+    std::vector<KeyEvent> schedule;
+    bool psel = GF2Device::PSEL0;
+    uint64_t time = 0;
+    schedule.push_back({time, psel, '\0', KEY_PSEL, 0});
+    schedule.push_back({time, true, '\0', KEY_DAC, 0});  // Enable the AD9834 internal DAC
+    time += PSK31_SYMBOL;  // A symbol of steady carrier serves as the reference for the first reversal
+    for (int i = 0; i < IDLE_SYMBOLS; ++i) {
+        compileBit(false, psel, time, schedule);
+    }
+    size_t strLength = message.size();
+    for (size_t i = 0; i < strLength; ++i) {
+        compilePSK31Character(message[i], psel, time, schedule);
+    }
+    time += IDLE_SYMBOLS * PSK31_SYMBOL;
+    schedule.push_back({time, false, '\0', KEY_DAC, 0});  // Disable the AD9834 internal DAC, which also marks the end of the message
+    return schedule;
+}
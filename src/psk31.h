@@ -0,0 +1,37 @@
+/* PSK31 functions - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef PSK31_H
+#define PSK31_H
+
+// Includes
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "keyer.h"
+
+// Definitions
+const uint64_t PSK31_SYMBOL = 32000000;  // Symbol period in ns, corresponding to 31.25 baud
+
+// Function prototypes
+void compilePSK31Character(char character, bool &psel, uint64_t &time, std::vector<KeyEvent> &schedule);
+std::vector<KeyEvent> compilePSK31Message(const std::string &message);
+
+#endif  // PSK31_H
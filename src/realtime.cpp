@@ -0,0 +1,102 @@
+/* Real-time scheduling helpers - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <sys/mman.h>
+#include "realtime.h"
+
+// Private procedure used to apply the given priority and CPU to the thread of the given state, saving its previous settings
+void RealTimeScope::apply(ThreadState &state, int priority, int cpu)
+{
+    state.fifo = false;
+    state.pinned = false;
+    if (cpu >= 0 && cpu < CPU_SETSIZE && pthread_getaffinity_np(state.thread, sizeof(state.affinity), &state.affinity) == 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        state.pinned = pthread_setaffinity_np(state.thread, sizeof(cpus), &cpus) == 0;  // Fails if the CPU does not exist, or is not allowed
+    }
+    if (priority > 0 && pthread_getschedparam(state.thread, &state.policy, &state.param) == 0) {
+        sched_param param = state.param;
+        param.sched_priority = priority;
+        state.fifo = pthread_setschedparam(state.thread, SCHED_FIFO, &param) == 0;  // Requires CAP_SYS_NICE, or a sufficient RLIMIT_RTPRIO
+    }
+}
+
+// Private procedure used to restore the settings saved by apply()
+void RealTimeScope::restore(const ThreadState &state)
+{
+    if (state.fifo) {
+        pthread_setschedparam(state.thread, state.policy, &state.param);
+    }
+    if (state.pinned) {
+        pthread_setaffinity_np(state.thread, sizeof(state.affinity), &state.affinity);
+    }
+}
+
+RealTimeScope::RealTimeScope(const RealTimeSettings &settings, const pthread_t *helper) :
+    locked_(false),
+    helperUsed_(helper != nullptr),
+    caller_(),
+    helper_()
+{
+    if (settings.lockMemory) {
+        locked_ = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;  // Requires CAP_IPC_LOCK, or a sufficient RLIMIT_MEMLOCK
+    }
+    caller_.thread = pthread_self();
+    apply(caller_, settings.priority, settings.cpu);
+    if (helperUsed_) {
+        int priority = settings.priority;
+        if (priority > 0 && priority < sched_get_priority_max(SCHED_FIFO)) {
+            ++priority;
+        }
+        helper_.thread = *helper;
+        apply(helper_, priority, settings.cpu);
+    }
+}
+
+RealTimeScope::~RealTimeScope()
+{
+    if (helperUsed_) {
+        restore(helper_);
+    }
+    restore(caller_);
+    if (locked_) {
+        munlockall();
+    }
+}
+
+// Returns true if the calling thread is running under SCHED_FIFO
+bool RealTimeScope::isFIFO() const
+{
+    return caller_.fifo;
+}
+
+// Returns true if all memory is locked
+bool RealTimeScope::isLocked() const
+{
+    return locked_;
+}
+
+// Returns true if the calling thread is pinned to the requested CPU
+bool RealTimeScope::isPinned() const
+{
+    return caller_.pinned;
+}
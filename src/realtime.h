@@ -0,0 +1,63 @@
+/* Real-time scheduling helpers - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef REALTIME_H
+#define REALTIME_H
+
+// Includes
+#include <pthread.h>
+#include <sched.h>
+
+struct RealTimeSettings {
+    int priority;     // SCHED_FIFO priority to be applied to the keying thread, or zero to keep the current scheduling policy
+    int cpu;          // CPU the keying thread is to be pinned to, or -1 to keep the current affinity
+    bool lockMemory;  // True if all memory is to be locked with mlockall(), so that no page faults take place while keying
+};
+
+// Applies the given real-time settings to the calling thread for the lifetime of the object, and restores the previous ones afterwards
+// If a helper thread is also given, such as the thread that completes USB transfers, it is pinned to the same CPU and runs one priority level above the calling thread, so that it is never held up while the calling thread spins
+// Each setting is applied independently, and any that cannot be applied (usually, due to insufficient privileges) is simply skipped
+class RealTimeScope
+{
+private:
+    struct ThreadState {
+        pthread_t thread;
+        bool fifo, pinned;
+        int policy;
+        sched_param param;
+        cpu_set_t affinity;
+    };
+
+    bool locked_, helperUsed_;
+    ThreadState caller_, helper_;
+
+    static void apply(ThreadState &state, int priority, int cpu);
+    static void restore(const ThreadState &state);
+
+public:
+    explicit RealTimeScope(const RealTimeSettings &settings, const pthread_t *helper = nullptr);
+    ~RealTimeScope();
+
+    bool isFIFO() const;
+    bool isLocked() const;
+    bool isPinned() const;
+};
+
+#endif  // REALTIME_H
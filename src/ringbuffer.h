@@ -0,0 +1,80 @@
+/* Lock-free ring buffer template - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+// Includes
+#include <atomic>
+#include <cstddef>
+
+// Single-producer, single-consumer ring buffer, holding up to "N" elements
+// push() must only be called by the producer thread, and pop() must only be called by the consumer thread
+template <typename T, size_t N>
+class RingBuffer
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "Ring buffer size must be a power of two");
+
+private:
+    T elements_[N];
+    std::atomic<size_t> head_;  // Index of the next element to be written (only modified by the producer)
+    std::atomic<size_t> tail_;  // Index of the next element to be read (only modified by the consumer)
+
+public:
+    RingBuffer() :
+        head_(0),
+        tail_(0)
+    {
+    }
+
+    // Returns true if the ring buffer is empty (only reliable if called by the consumer)
+    bool empty() const
+    {
+        return tail_.load(std::memory_order_relaxed) == head_.load(std::memory_order_acquire);
+    }
+
+    // Reads and removes the oldest element, returning false if the ring buffer is empty
+    bool pop(T &element)
+    {
+        bool success = false;
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail != head_.load(std::memory_order_acquire)) {
+            element = elements_[tail % N];
+            tail_.store(tail + 1, std::memory_order_release);  // The slot is released only after the element is copied
+            success = true;
+        }
+        return success;
+    }
+
+    // Appends the given element, returning false if the ring buffer is full
+    bool push(const T &element)
+    {
+        bool success = false;
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) < N) {
+            elements_[head % N] = element;
+            head_.store(head + 1, std::memory_order_release);  // The element is published only after it is written
+            success = true;
+        }
+        return success;
+    }
+};
+
+#endif  // RINGBUFFER_H
@@ -0,0 +1,87 @@
+/* Rolling median template - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+
+#ifndef ROLLINGMEDIAN_H
+#define ROLLINGMEDIAN_H
+
+// Includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+// Median of the last "N" values pushed, which is robust against the occasional outlier (e.g., a transfer delayed by the scheduler)
+// No allocations take place, so that values can be pushed and the median taken while keying
+template <size_t N>
+class RollingMedian
+{
+    static_assert(N > 0, "Rolling median window must not be empty");
+
+private:
+    int64_t values_[N];
+    size_t count_;  // Number of values pushed, saturating at "N"
+    size_t next_;   // Index of the slot to be overwritten by the next value
+
+public:
+    RollingMedian() :
+        values_(),
+        count_(0),
+        next_(0)
+    {
+    }
+
+    // Returns true if no values were pushed since the rolling median was created or cleared
+    bool empty() const
+    {
+        return count_ == 0;
+    }
+
+    // Returns the median of the values in the window (the upper median, if their number is even), or zero if there are none
+    int64_t median() const
+    {
+        int64_t sorted[N];
+        std::copy(values_, values_ + count_, sorted);
+        std::nth_element(sorted, sorted + count_ / 2, sorted + count_);
+        return count_ == 0 ? 0 : sorted[count_ / 2];
+    }
+
+    // Returns the number of values in the window
+    size_t size() const
+    {
+        return count_;
+    }
+
+    // Discards all values
+    void clear()
+    {
+        count_ = 0;
+        next_ = 0;
+    }
+
+    // Adds the given value to the window, replacing the oldest one if the window is full
+    void push(int64_t value)
+    {
+        values_[next_] = value;
+        next_ = (next_ + 1) % N;
+        count_ = count_ < N ? count_ + 1 : N;
+    }
+};
+
+#endif  // ROLLINGMEDIAN_H
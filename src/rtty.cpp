@@ -0,0 +1,106 @@
+/* RTTY functions - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include "rtty.h"
+
+// Definitions
+const uint8_t FIGS = 0x1b;        // Figure shift code
+const uint8_t LTRS = 0x1f;        // Letter shift code
+const int IDLE_BITS = 45;         // Number of bits of steady mark in the preamble and in the postamble (about one second)
+const int SHIFT_UNKNOWN = -1;     // Shift state after a space, given that some receivers return to letters on a space
+const int SHIFT_LETTERS = 0;
+const int SHIFT_FIGURES = 1;
+
+// ITA2 characters, indexed by code, in the letter and figure shifts (codes without a character, or that are independent of the shift, correspond to '\0' in the figure shift)
+// The positions left for national use are filled with the US TTY characters
+static constexpr char LETTERS[32] = {'\0', 'E', '\n', 'A', ' ', 'S', 'I', 'U', '\r', 'D', 'R', 'J', 'N', 'F', 'C', 'K', 'T', 'Z', 'L', 'W', 'H', 'Y', 'P', 'Q', 'O', 'B', 'G', '\0', 'M', 'X', 'V', '\0'};
+static constexpr char FIGURES[32] = {'\0', '3', '\0', '-', '\0', '\'', '8', '7', '\0', '$', '4', '\a', ',', '!', ':', '(', '5', '+', ')', '2', '#', '6', '0', '1', '9', '?', '&', '\0', '.', '/', '=', '\0'};
+
+// Appends the events that signal the given code to the schedule, framed by a start bit and 1.5 stop bits
+// Mark (a one) corresponds to FREQ0, and space (a zero) to FREQ1, while the line rests at mark between codes
+// Events are only added when the tone changes, so that each one corresponds to a transition
+static void compileCode(uint8_t code, char character, uint64_t &time, std::vector<KeyEvent> &schedule)
+{
+    schedule.push_back({time, true, character});  // Does not change the state of the DAC, but displays the character along with its start bit
+    schedule.push_back({time, GF2Device::FSEL1, '\0', KEY_FSEL, 0});  // Start bit (space)
+    bool fsel = GF2Device::FSEL1;
+    time += RTTY_BIT;
+    for (int i = 0; i < 5; ++i) {  // Data bits, least significant bit first
+        bool bit = (0x01 << i & code) != 0x00;
+        if (bit == (fsel == GF2Device::FSEL1)) {  // The bit differs from the current tone
+            fsel = bit ? GF2Device::FSEL0 : GF2Device::FSEL1;
+            schedule.push_back({time, fsel, '\0', KEY_FSEL, 0});
+        }
+        time += RTTY_BIT;
+    }
+    if (fsel != GF2Device::FSEL0) {
+        schedule.push_back({time, GF2Device::FSEL0, '\0', KEY_FSEL, 0});  // Stop bits (mark)
+    }
+    time += 3 * RTTY_BIT / 2;
+}
+
+// Appends the events that signal the given character to the schedule, preceded by a shift code if the current shift does not apply
+// Returns are sent as CR followed by LF, and characters without an ITA2 code are ignored
+static void compileCharacter(char character, int &shift, uint64_t &time, std::vector<KeyEvent> &schedule)
+{
+    if (character >= 'a' && character <= 'z') {  // If lowercase
+        character -= 32;  // Convert to uppercase
+    }
+    if (character == '\n') {
+        compileCode(0x08, '\0', time, schedule);  // CR
+        compileCode(0x02, '\n', time, schedule);  // LF
+    } else if (character != '\0') {
+        for (uint8_t code = 0; code < 32; ++code) {
+            if (character == LETTERS[code] || character == FIGURES[code]) {
+                int required = character == LETTERS[code] ? (code == 0x04 || code == 0x08 ? shift : SHIFT_LETTERS) : SHIFT_FIGURES;  // Spaces and returns are valid in both shifts
+                if (required != shift) {
+                    compileCode(required == SHIFT_FIGURES ? FIGS : LTRS, '\0', time, schedule);
+                    shift = required;
+                }
+                compileCode(code, character, time, schedule);
+                if (code == 0x04) {  // Space
+                    shift = shift == SHIFT_FIGURES ? SHIFT_UNKNOWN : shift;  // The figure shift is sent again after a space, for the benefit of receivers that unshift on space
+                }
+                break;
+            }
+        }
+    }
+}
+
+// Compiles the given message into a schedule of timed events, to be signaled in RTTY (ITA2 at 45.45 baud)
+// FREQ0 and FREQ1 must be set to the mark and space frequencies beforehand, so that keying is done by toggling FSEL alone, which keeps the phase continuous
+std::vector<KeyEvent> compileRTTYMessage(const std::string &message)
+{
+    std::vector<KeyEvent> schedule;
+    int shift = SHIFT_LETTERS;
+    uint64_t time = 0;
+    schedule.push_back({time, GF2Device::FSEL0, '\0', KEY_FSEL, 0});  // Mark
+    schedule.push_back({time, true, '\0', KEY_DAC, 0});  // Enable the AD9834 internal DAC
+    time += IDLE_BITS * RTTY_BIT;
+    compileCode(LTRS, '\0', time, schedule);  // Places receivers in the letter shift, whatever their state
+    size_t strLength = message.size();
+    for (size_t i = 0; i < strLength; ++i) {
+        compileCharacter(message[i], shift, time, schedule);
+    }
+    time += IDLE_BITS * RTTY_BIT;
+    schedule.push_back({time, false, '\0', KEY_DAC, 0});  // Disable the AD9834 internal DAC, which also marks the end of the message
+    return schedule;
+}
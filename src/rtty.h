@@ -0,0 +1,37 @@
+/* RTTY functions - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef RTTY_H
+#define RTTY_H
+
+// Includes
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "keyer.h"
+
+// Definitions
+const uint64_t RTTY_BIT = 22002200;  // Bit period in ns, corresponding to 45.45 baud
+const float RTTY_SHIFT = 170;        // Default frequency shift between the mark and space tones, in Hz
+
+// Function prototypes
+std::vector<KeyEvent> compileRTTYMessage(const std::string &message);
+
+#endif  // RTTY_H
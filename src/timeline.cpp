@@ -0,0 +1,253 @@
+/* Timeline class - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <iomanip>
+#include <string>
+#include "keyer.h"
+#include "timeline.h"
+
+// Definitions
+static const char *const ACTION_NAMES[] = {"DAC", "FSEL", "PSEL"};  // Names of the actions, indexed by action
+
+Timeline::Timeline(size_t capacity) :
+    entries_(),
+    recorded_(0)
+{
+    entries_.reserve(capacity);
+}
+
+// Returns the entry at the given index, where index zero corresponds to the oldest entry that was kept
+const Timeline::Entry &Timeline::operator [](size_t index) const
+{
+    return entries_[recorded_ > entries_.capacity() ? (recorded_ + index) % entries_.capacity() : index];
+}
+
+// Returns the maximum number of entries that can be kept
+size_t Timeline::capacity() const
+{
+    return entries_.capacity();
+}
+
+// Returns the number of entries that were overwritten, since the ring buffer was full
+size_t Timeline::dropped() const
+{
+    return recorded_ - entries_.size();
+}
+
+// Returns the number of entries kept
+size_t Timeline::size() const
+{
+    return entries_.size();
+}
+
+// Returns a summary of the timeline, including the effective speed if the given time unit (in ns) is not zero
+// Element length errors are calculated from the completion times of each DAC on and off pair, which is when the signal is actually keyed
+Timeline::Summary Timeline::summary(uint64_t tunit) const
+{
+    Summary summary = {0, 0, 0, 0, 0, 0, 0};
+    size_t entriesSize = entries_.size();
+    int64_t onIdeal = 0, onCompletion = 0, firstIdeal = 0, firstCompletion = 0, lastIdeal = 0, lastCompletion = 0;
+    int64_t wakeupSum = 0, transferSum = 0, errorSum = 0;
+    double errorSquares = 0;
+    bool on = false;
+    for (size_t i = 0; i < entriesSize; ++i) {
+        const Entry &entry = (*this)[i];
+        wakeupSum += entry.issue - entry.ideal;
+        transferSum += entry.completion - entry.issue;
+        if (entry.action == KEY_DAC) {
+            if (entry.value) {
+                if (summary.elements == 0) {
+                    firstIdeal = entry.ideal;
+                    firstCompletion = entry.completion;
+                }
+                onIdeal = entry.ideal;
+                onCompletion = entry.completion;
+                on = true;
+            } else if (on) {
+                int64_t error = (entry.completion - onCompletion) - (entry.ideal - onIdeal);
+                ++summary.elements;
+                errorSum += error;
+                errorSquares += static_cast<double>(error) * static_cast<double>(error);
+                summary.elementMax = std::max(summary.elementMax, error < 0 ? -error : error);
+                lastIdeal = entry.ideal;
+                lastCompletion = entry.completion;
+                on = false;
+            }
+        }
+    }
+    if (entriesSize > 0) {
+        summary.wakeupMean = wakeupSum / static_cast<int64_t>(entriesSize);
+        summary.transferMean = transferSum / static_cast<int64_t>(entriesSize);
+    }
+    if (summary.elements > 0) {
+        double mean = static_cast<double>(errorSum) / static_cast<double>(summary.elements);
+        summary.elementMean = static_cast<int64_t>(mean);
+        summary.elementStdDev = static_cast<int64_t>(std::sqrt(std::max(0.0, errorSquares / static_cast<double>(summary.elements) - mean * mean)));
+        if (tunit > 0 && lastCompletion > firstCompletion) {
+            summary.effectiveWPM = 1.2e9 / static_cast<double>(tunit) * static_cast<double>(lastIdeal - firstIdeal) / static_cast<double>(lastCompletion - firstCompletion);  // A dot lasting 1.2s corresponds to 1 WPM
+        }
+    }
+    return summary;
+}
+
+// Removes all entries, keeping the allocated capacity
+void Timeline::clear()
+{
+    entries_.clear();
+    recorded_ = 0;
+}
+
+// Prints the timeline, one transition per line (times are displayed in microseconds)
+void Timeline::print(std::ostream &stream) const
+{
+    stream << "Timing trace:\n";
+    size_t entriesSize = entries_.size();
+    for (size_t i = 0; i < entriesSize; ++i) {
+        const Entry &entry = (*this)[i];
+        stream << "  " << std::setw(12) << entry.ideal / 1000 << "us " << std::setw(4) << ACTION_NAMES[entry.action] << " " << entry.value << " " << std::setw(8) << (entry.completion - entry.ideal) / 1000 << "us\n";
+    }
+    if (dropped() > 0) {
+        stream << "  (" << dropped() << " earlier transitions not kept)\n";
+    }
+}
+
+// Prints a summary of the timeline, including the effective speed if the given time unit (in ns) is not zero (values are displayed in microseconds)
+void Timeline::printSummary(std::ostream &stream, uint64_t tunit) const
+{
+    Summary summary = this->summary(tunit);
+    stream << "Timeline summary:\n"
+           << "  Elements: " << summary.elements << "\n";
+    if (tunit > 0) {
+        stream << "  Effective speed: " << std::fixed << std::setprecision(2) << summary.effectiveWPM << " WPM (intended " << 1.2e9 / static_cast<double>(tunit) << " WPM)\n" << std::defaultfloat;
+    }
+    stream << "  Mean element length error: " << summary.elementMean / 1000 << "us\n"
+           << "  Element jitter (standard deviation): " << summary.elementStdDev / 1000 << "us\n"
+           << "  Maximum element length error: " << summary.elementMax / 1000 << "us\n"
+           << "  Mean wakeup delay: " << summary.wakeupMean / 1000 << "us\n"
+           << "  Mean transfer time: " << summary.transferMean / 1000 << "us\n";
+}
+
+// Records the given entry, overwriting the oldest one if the ring buffer is full (no allocations take place, and nothing is recorded if the capacity is zero)
+void Timeline::record(const Entry &entry)
+{
+    size_t capacity = entries_.capacity();
+    if (entries_.size() < capacity) {
+        entries_.push_back(entry);
+    } else if (capacity > 0) {
+        entries_[recorded_ % capacity] = entry;
+    }
+    if (capacity > 0) {
+        ++recorded_;
+    }
+}
+
+// Sets the capacity of the ring buffer, which also clears it (this allocates memory, so it should not be called while keying)
+void Timeline::reserve(size_t capacity)
+{
+    std::vector<Entry> entries;
+    entries.reserve(capacity);
+    entries_.swap(entries);
+    recorded_ = 0;
+}
+
+// Writes the timeline in CSV format, one transition per line (times are given in nanoseconds)
+void Timeline::writeCSV(std::ostream &stream) const
+{
+    stream << "action,value,ideal_ns,issue_ns,completion_ns,wakeup_ns,error_ns\n";
+    size_t entriesSize = entries_.size();
+    for (size_t i = 0; i < entriesSize; ++i) {
+        const Entry &entry = (*this)[i];
+        stream << ACTION_NAMES[entry.action] << "," << entry.value << "," << entry.ideal << "," << entry.issue << "," << entry.completion << "," << entry.issue - entry.ideal << "," << entry.completion - entry.ideal << "\n";
+    }
+}
+
+// Writes the timeline in VCD format, so that it can be viewed along with a logic analyzer capture (the time scale is 1ns)
+// Each of DAC, FSEL and PSEL is given as an ideal signal, which changes at the ideal times, and an actual one, which changes at the completion times, while "busy" is high while any transfer is in flight
+// VCD times cannot be negative, so if any transfer was issued before the start (e.g. ahead of a UTC start, with latency compensation), all times are shifted so that the earliest one becomes zero, and the shift is noted in a comment
+void Timeline::writeVCD(std::ostream &stream) const
+{
+    struct Change {
+        int64_t time;
+        char id;
+        char value;
+    };
+    static const char IDEAL_IDS[] = {'!', '#', '%'};   // Identifiers of the ideal signals, indexed by action
+    static const char ACTUAL_IDS[] = {'"', '$', '&'};  // Identifiers of the actual signals, indexed by action
+    static const char BUSY_ID = '\'';
+    std::vector<Change> changes;
+    size_t entriesSize = entries_.size();
+    changes.reserve(4 * entriesSize);
+    for (size_t i = 0; i < entriesSize; ++i) {
+        const Entry &entry = (*this)[i];
+        char value = entry.value ? '1' : '0';
+        changes.push_back({entry.ideal, IDEAL_IDS[entry.action], value});
+        changes.push_back({entry.issue, BUSY_ID, '1'});
+        changes.push_back({entry.completion, ACTUAL_IDS[entry.action], value});
+        changes.push_back({entry.completion, BUSY_ID, '0'});
+    }
+    std::stable_sort(changes.begin(), changes.end(), [](const Change &a, const Change &b) {  // At the same time, transfers are issued before others complete, so that "busy" does not glitch low
+        int rankA = a.id == BUSY_ID && a.value == '0', rankB = b.id == BUSY_ID && b.value == '0';
+        return a.time < b.time || (a.time == b.time && rankA < rankB);
+    });
+    int64_t origin = changes.empty() || changes[0].time > 0 ? 0 : changes[0].time;
+    stream << "$version gf2-morse $end\n";
+    if (origin < 0) {
+        stream << "$comment Time 0 is " << -origin << "ns before the start $end\n";
+    }
+    stream << "$timescale 1ns $end\n"
+           << "$scope module gf2 $end\n";
+    for (size_t i = 0; i < 3; ++i) {
+        std::string name(ACTION_NAMES[i]);
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        stream << "$var wire 1 " << IDEAL_IDS[i] << " " << name << "_ideal $end\n"
+               << "$var wire 1 " << ACTUAL_IDS[i] << " " << name << " $end\n";
+    }
+    stream << "$var wire 1 " << BUSY_ID << " busy $end\n"
+           << "$upscope $end\n"
+           << "$enddefinitions $end\n"
+           << "#0\n"
+           << "$dumpvars\n"
+           << "0" << IDEAL_IDS[0] << "\n0" << ACTUAL_IDS[0] << "\n"  // The DAC is known to be disabled at the start, but the selected registers are not known
+           << "x" << IDEAL_IDS[1] << "\nx" << ACTUAL_IDS[1] << "\n"
+           << "x" << IDEAL_IDS[2] << "\nx" << ACTUAL_IDS[2] << "\n"
+           << "0" << BUSY_ID << "\n"
+           << "$end\n";
+    int64_t time = 0;
+    int inFlight = 0;  // Number of transfers in flight, since "busy" only falls once all of them complete
+    size_t changesSize = changes.size();
+    for (size_t i = 0; i < changesSize; ++i) {
+        const Change &change = changes[i];
+        if (change.id == BUSY_ID) {
+            inFlight += change.value == '1' ? 1 : -1;
+            if (inFlight != (change.value == '1' ? 1 : 0)) {  // Only the first issue and the last completion change "busy"
+                continue;
+            }
+        }
+        if (change.time - origin != time) {
+            time = change.time - origin;
+            stream << "#" << time << "\n";
+        }
+        stream << change.value << change.id << "\n";
+    }
+}
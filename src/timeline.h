@@ -0,0 +1,76 @@
+/* Timeline class - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+// Includes
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Record of the transitions that actually took place while keying, to be exported once keying ends
+// Entries are kept in a ring buffer that is allocated beforehand, so that recording never allocates, and the oldest entries are overwritten once it is full
+class Timeline
+{
+public:
+    struct Entry {
+        uint8_t action;      // Action taken (KEY_DAC, KEY_FSEL or KEY_PSEL)
+        bool value;          // DAC state set, or register selected
+        int64_t ideal;       // Ideal time of the transition (in ns, relative to the start of the run)
+        int64_t issue;       // Time when the corresponding transfer was issued
+        int64_t completion;  // Time when the corresponding transfer completed, which is when the transition is deemed to take place
+    };
+
+    struct Summary {
+        size_t elements;        // Number of keyed elements (DAC on and off pairs)
+        double effectiveWPM;    // Effective speed, given by the intended speed scaled by the ratio between the ideal and actual keying times (zero if not applicable)
+        int64_t elementMean;    // Mean element length error (in ns)
+        int64_t elementStdDev;  // Standard deviation of the element length error, which is the element jitter (in ns)
+        int64_t elementMax;     // Maximum absolute element length error (in ns)
+        int64_t wakeupMean;     // Mean delay between ideal and issue times (in ns)
+        int64_t transferMean;   // Mean delay between issue and completion times (in ns)
+    };
+
+private:
+    std::vector<Entry> entries_;
+    size_t recorded_;  // Number of entries recorded since the last clear, including overwritten ones
+
+public:
+    explicit Timeline(size_t capacity = 0);
+
+    const Entry &operator [](size_t index) const;
+
+    size_t capacity() const;
+    size_t dropped() const;
+    size_t size() const;
+    Summary summary(uint64_t tunit = 0) const;
+
+    void clear();
+    void print(std::ostream &stream) const;
+    void printSummary(std::ostream &stream, uint64_t tunit = 0) const;
+    void record(const Entry &entry);
+    void reserve(size_t capacity);
+    void writeCSV(std::ostream &stream) const;
+    void writeVCD(std::ostream &stream) const;
+};
+
+#endif  // TIMELINE_H
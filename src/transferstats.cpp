@@ -0,0 +1,269 @@
+/* TransferStatistics class - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <iomanip>
+#include <sstream>
+#include "transferstats.h"
+
+// Names of the control requests of the CP2130, indexed by request code (requests without a name correspond to a null pointer)
+static const char *requestName(uint8_t request)
+{
+    static const struct {
+        uint8_t request;
+        const char *name;
+    } NAMES[] = {
+        {CP2130::RESET_DEVICE, "RESET_DEVICE"},
+        {CP2130::GET_READONLY_VERSION, "GET_READONLY_VERSION"},
+        {CP2130::GET_GPIO_VALUES, "GET_GPIO_VALUES"},
+        {CP2130::SET_GPIO_VALUES, "SET_GPIO_VALUES"},
+        {CP2130::GET_GPIO_MODE_AND_LEVEL, "GET_GPIO_MODE_AND_LEVEL"},
+        {CP2130::SET_GPIO_MODE_AND_LEVEL, "SET_GPIO_MODE_AND_LEVEL"},
+        {CP2130::GET_GPIO_CHIP_SELECT, "GET_GPIO_CHIP_SELECT"},
+        {CP2130::SET_GPIO_CHIP_SELECT, "SET_GPIO_CHIP_SELECT"},
+        {CP2130::GET_SPI_WORD, "GET_SPI_WORD"},
+        {CP2130::SET_SPI_WORD, "SET_SPI_WORD"},
+        {CP2130::GET_SPI_DELAY, "GET_SPI_DELAY"},
+        {CP2130::SET_SPI_DELAY, "SET_SPI_DELAY"},
+        {CP2130::GET_FULL_THRESHOLD, "GET_FULL_THRESHOLD"},
+        {CP2130::SET_FULL_THRESHOLD, "SET_FULL_THRESHOLD"},
+        {CP2130::GET_RTR_STATE, "GET_RTR_STATE"},
+        {CP2130::SET_RTR_STOP, "SET_RTR_STOP"},
+        {CP2130::GET_EVENT_COUNTER, "GET_EVENT_COUNTER"},
+        {CP2130::SET_EVENT_COUNTER, "SET_EVENT_COUNTER"},
+        {CP2130::GET_CLOCK_DIVIDER, "GET_CLOCK_DIVIDER"},
+        {CP2130::SET_CLOCK_DIVIDER, "SET_CLOCK_DIVIDER"},
+        {CP2130::GET_USB_CONFIG, "GET_USB_CONFIG"},
+        {CP2130::SET_USB_CONFIG, "SET_USB_CONFIG"},
+        {CP2130::GET_MANUFACTURING_STRING_1, "GET_MANUFACTURING_STRING_1"},
+        {CP2130::SET_MANUFACTURING_STRING_1, "SET_MANUFACTURING_STRING_1"},
+        {CP2130::GET_MANUFACTURING_STRING_2, "GET_MANUFACTURING_STRING_2"},
+        {CP2130::SET_MANUFACTURING_STRING_2, "SET_MANUFACTURING_STRING_2"},
+        {CP2130::GET_PRODUCT_STRING_1, "GET_PRODUCT_STRING_1"},
+        {CP2130::SET_PRODUCT_STRING_1, "SET_PRODUCT_STRING_1"},
+        {CP2130::GET_PRODUCT_STRING_2, "GET_PRODUCT_STRING_2"},
+        {CP2130::SET_PRODUCT_STRING_2, "SET_PRODUCT_STRING_2"},
+        {CP2130::GET_SERIAL_STRING, "GET_SERIAL_STRING"},
+        {CP2130::SET_SERIAL_STRING, "SET_SERIAL_STRING"},
+        {CP2130::GET_PIN_CONFIG, "GET_PIN_CONFIG"},
+        {CP2130::SET_PIN_CONFIG, "SET_PIN_CONFIG"},
+        {CP2130::GET_LOCK_BYTE, "GET_LOCK_BYTE"},
+        {CP2130::SET_LOCK_BYTE, "SET_LOCK_BYTE"},
+        {CP2130::GET_PROM_CONFIG, "GET_PROM_CONFIG"},
+        {CP2130::SET_PROM_CONFIG, "SET_PROM_CONFIG"}
+    };
+    const char *name = nullptr;
+    for (size_t i = 0; i < sizeof(NAMES) / sizeof(NAMES[0]); ++i) {
+        if (NAMES[i].request == request) {
+            name = NAMES[i].name;
+            break;
+        }
+    }
+    return name;
+}
+
+TransferStatistics::Histogram::Histogram() :
+    count(0),
+    errors(0),
+    bytes(0),
+    sum(0),
+    max(0)
+{
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+// Private function that returns the histogram corresponding to the given operation, which is allocated on first use
+// Allocation is lock-free, as concurrent allocations of the same histogram are resolved by keeping the first one
+TransferStatistics::Histogram &TransferStatistics::histogram(size_t operation)
+{
+    Histogram *histogram = histograms_[operation].load(std::memory_order_acquire);
+    if (histogram == nullptr) {
+        Histogram *expected = nullptr;
+        histogram = new Histogram;
+        if (!histograms_[operation].compare_exchange_strong(expected, histogram, std::memory_order_acq_rel)) {
+            delete histogram;
+            histogram = expected;
+        }
+    }
+    return *histogram;
+}
+
+// Private static function that returns the index of the bucket that holds the given latency (in ns)
+// Latencies below SUB_BUCKETS have one bucket each, while greater ones are split in SUB_BUCKETS buckets per power of two
+size_t TransferStatistics::bucketIndex(int64_t latency)
+{
+    size_t index;
+    uint64_t value = latency < 0 ? 0 : static_cast<uint64_t>(latency);
+    if (value < SUB_BUCKETS) {
+        index = static_cast<size_t>(value);
+    } else {
+        size_t exponent = 63 - static_cast<size_t>(__builtin_clzll(value));  // Position of the most significant bit, which is at least 4
+        index = (exponent - 3) * SUB_BUCKETS + static_cast<size_t>(value >> (exponent - 4) & (SUB_BUCKETS - 1));
+    }
+    return index < BUCKETS ? index : BUCKETS - 1;
+}
+
+// Private static function that returns the latency represented by the given bucket, which is the midpoint of the bucket (in ns)
+int64_t TransferStatistics::bucketValue(size_t index)
+{
+    int64_t value;
+    if (index < SUB_BUCKETS) {
+        value = static_cast<int64_t>(index);
+    } else {
+        size_t exponent = index / SUB_BUCKETS + 3;
+        int64_t width = static_cast<int64_t>(1) << (exponent - 4);
+        value = static_cast<int64_t>(SUB_BUCKETS + index % SUB_BUCKETS) * width + width / 2;
+    }
+    return value;
+}
+
+// Private static function that returns the name of the given operation
+std::string TransferStatistics::operationName(size_t operation)
+{
+    static const char *const COMMAND_NAMES[] = {"READ", "WRITE", "WRITEREAD", "CMD3", "READWITHRTR"};
+    std::ostringstream stream;
+    if (operation < 256) {
+        const char *name = requestName(static_cast<uint8_t>(operation));
+        if (name != nullptr) {
+            stream << name;
+        } else {
+            stream << "CONTROL_0x" << std::hex << std::setfill('0') << std::setw(2) << operation;
+        }
+    } else {
+        size_t command = (operation - 256) % 16;
+        stream << (operation < 256 + 16 ? "BULK_OUT" : "BULK_IN");
+        if (operation < 256 + 16) {  // The SPI command is only known for bulk OUT transfers
+            stream << "_";
+            if (command < sizeof(COMMAND_NAMES) / sizeof(COMMAND_NAMES[0])) {
+                stream << COMMAND_NAMES[command];
+            } else {
+                stream << "CMD" << command;
+            }
+        }
+    }
+    return stream.str();
+}
+
+// Timestamps are taken from the given clock, so that simulated transfers are measured in virtual time if a virtual clock is used
+TransferStatistics::TransferStatistics(const Clock &clock) :
+    clock_(clock)
+{
+    for (size_t i = 0; i < OPERATIONS; ++i) {
+        histograms_[i].store(nullptr, std::memory_order_relaxed);
+    }
+    histogram(CP2130::GET_GPIO_VALUES);  // The histograms of the operations used while keying are allocated beforehand, so that no allocations take place on the hot path
+    histogram(CP2130::SET_GPIO_VALUES);
+    histogram(CP2130::SET_GPIO_CHIP_SELECT);
+    histogram(256 + CP2130::WRITE);
+}
+
+TransferStatistics::~TransferStatistics()
+{
+    for (size_t i = 0; i < OPERATIONS; ++i) {
+        delete histograms_[i].load(std::memory_order_acquire);
+    }
+}
+
+// Returns a summary of each operation that took place at least once, in order of operation (control requests first, by request code, and then bulk transfers)
+std::vector<TransferStatistics::Summary> TransferStatistics::summaries() const
+{
+    std::vector<Summary> summaries;
+    for (size_t i = 0; i < OPERATIONS; ++i) {
+        const Histogram *histogram = histograms_[i].load(std::memory_order_acquire);
+        uint64_t count = histogram == nullptr ? 0 : histogram->count.load(std::memory_order_acquire);
+        if (count > 0) {
+            uint64_t buckets[BUCKETS], total = 0;
+            for (size_t j = 0; j < BUCKETS; ++j) {  // The buckets are copied first, so that percentiles are consistent even if transfers are recorded meanwhile
+                buckets[j] = histogram->buckets[j].load(std::memory_order_relaxed);
+                total += buckets[j];
+            }
+            int64_t max = histogram->max.load(std::memory_order_relaxed);
+            int64_t percentiles[2] = {0, 0};
+            const uint64_t ranks[2] = {(total + 1) / 2, (99 * total + 99) / 100};  // Ranks of the 50th and 99th percentiles (rounded up)
+            uint64_t cumulative = 0;
+            size_t k = 0;
+            for (size_t j = 0; j < BUCKETS && k < 2; ++j) {
+                cumulative += buckets[j];
+                while (k < 2 && cumulative >= ranks[k] && ranks[k] > 0) {
+                    percentiles[k] = bucketValue(j) < max ? bucketValue(j) : max;  // The midpoint of the last bucket may exceed the maximum
+                    ++k;
+                }
+            }
+            summaries.push_back({operationName(i), count, histogram->errors.load(std::memory_order_relaxed), histogram->bytes.load(std::memory_order_relaxed), static_cast<int64_t>(histogram->sum.load(std::memory_order_relaxed) / count), percentiles[0], percentiles[1], max});
+        }
+    }
+    return summaries;
+}
+
+// Returns the current time of the clock, which is used to timestamp transfers
+int64_t TransferStatistics::timestamp() const
+{
+    return clock_.monotonicTime();
+}
+
+// Prints the median, 99th percentile and maximum latencies of each operation (latencies are displayed in microseconds)
+void TransferStatistics::print(std::ostream &stream) const
+{
+    std::vector<Summary> summaries = this->summaries();
+    stream << "Transfer statistics:\n"
+           << "  " << std::left << std::setw(28) << "Operation" << std::right << std::setw(8) << "Count" << std::setw(8) << "Errors" << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "Max" << "\n";
+    size_t summariesSize = summaries.size();
+    for (size_t i = 0; i < summariesSize; ++i) {
+        const Summary &summary = summaries[i];
+        stream << "  " << std::left << std::setw(28) << summary.operation << std::right << std::setw(8) << summary.count << std::setw(8) << summary.errors
+               << std::setw(8) << summary.p50 / 1000 << "us" << std::setw(8) << summary.p99 / 1000 << "us" << std::setw(8) << summary.max / 1000 << "us\n";
+    }
+}
+
+// Records the given transfer, without taking any locks
+void TransferStatistics::transferCompleted(const CP2130::TransferRecord &record)
+{
+    size_t operation = record.type == CP2130::TRANSFER_CONTROL ? record.request : 256 + (record.type == CP2130::TRANSFER_BULK_OUT ? 0 : 16) + (record.request & 0x0f);
+    Histogram &histogram = this->histogram(operation);
+    int64_t latency = record.end - record.start;
+    latency = latency < 0 ? 0 : latency;
+    histogram.buckets[bucketIndex(latency)].fetch_add(1, std::memory_order_relaxed);
+    histogram.sum.fetch_add(static_cast<uint64_t>(latency), std::memory_order_relaxed);
+    histogram.bytes.fetch_add(record.length < 0 ? 0 : static_cast<uint64_t>(record.length), std::memory_order_relaxed);
+    if (!record.success) {
+        histogram.errors.fetch_add(1, std::memory_order_relaxed);
+    }
+    int64_t max = histogram.max.load(std::memory_order_relaxed);
+    while (latency > max && !histogram.max.compare_exchange_weak(max, latency, std::memory_order_relaxed)) {
+    }
+    histogram.count.fetch_add(1, std::memory_order_release);  // Incremented last, so that a summary never counts a transfer whose latency is not yet recorded
+}
+
+// Writes the summary of each operation in JSON format (latencies are given in nanoseconds)
+void TransferStatistics::writeJSON(std::ostream &stream) const
+{
+    std::vector<Summary> summaries = this->summaries();
+    stream << "{\"operations\": [";
+    size_t summariesSize = summaries.size();
+    for (size_t i = 0; i < summariesSize; ++i) {
+        const Summary &summary = summaries[i];
+        stream << (i == 0 ? "\n" : ",\n")
+               << "  {\"operation\": \"" << summary.operation << "\", \"count\": " << summary.count << ", \"errors\": " << summary.errors << ", \"bytes\": " << summary.bytes
+               << ", \"mean_ns\": " << summary.mean << ", \"p50_ns\": " << summary.p50 << ", \"p99_ns\": " << summary.p99 << ", \"max_ns\": " << summary.max << "}";
+    }
+    stream << (summariesSize == 0 ? "]}\n" : "\n]}\n");
+}
@@ -0,0 +1,87 @@
+/* TransferStatistics class - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef TRANSFERSTATS_H
+#define TRANSFERSTATS_H
+
+// Includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "clock.h"
+#include "cp2130.h"
+
+// Transfer observer that aggregates the latency of every transfer into per-operation histograms
+// Histograms are log-linear (HDR-style), with 16 sub-buckets per power of two, so that percentiles are accurate to within 6.25% over the whole range, and recording only takes lock-free atomic increments
+class TransferStatistics : public CP2130::TransferObserver
+{
+public:
+    struct Summary {
+        std::string operation;  // Name of the operation (e.g., "SET_GPIO_VALUES" or "BULK_OUT_WRITE")
+        uint64_t count;         // Number of transfers
+        uint64_t errors;        // Number of failed transfers
+        uint64_t bytes;         // Number of bytes transferred (excluding setup packets)
+        int64_t mean;           // Mean latency (in ns)
+        int64_t p50;            // Median latency (in ns)
+        int64_t p99;            // 99th percentile latency (in ns)
+        int64_t max;            // Maximum latency (in ns)
+    };
+
+private:
+    static const size_t SUB_BUCKETS = 16;                  // Sub-buckets per power of two (must be a power of two)
+    static const size_t BUCKETS = 46 * SUB_BUCKETS;        // Enough to cover latencies up to 2^49ns (several days)
+    static const size_t OPERATIONS = 256 + 2 * 16;         // One per control request code, plus one per SPI command for each bulk direction
+
+    struct Histogram {
+        std::atomic<uint64_t> buckets[BUCKETS];
+        std::atomic<uint64_t> count, errors, bytes, sum;
+        std::atomic<int64_t> max;
+
+        Histogram();
+    };
+
+    const Clock &clock_;
+    std::atomic<Histogram *> histograms_[OPERATIONS];
+
+    Histogram &histogram(size_t operation);
+
+    static size_t bucketIndex(int64_t latency);
+    static int64_t bucketValue(size_t index);
+    static std::string operationName(size_t operation);
+
+public:
+    explicit TransferStatistics(const Clock &clock = Clock::system());
+    ~TransferStatistics();
+
+    TransferStatistics(const TransferStatistics &) = delete;  // Copying is not allowed, since the histograms are owned by the object
+    TransferStatistics &operator =(const TransferStatistics &) = delete;
+
+    std::vector<Summary> summaries() const;
+    int64_t timestamp() const override;
+
+    void print(std::ostream &stream) const;
+    void transferCompleted(const CP2130::TransferRecord &record) override;
+    void writeJSON(std::ostream &stream) const;
+};
+
+#endif  // TRANSFERSTATS_H